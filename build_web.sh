@@ -37,8 +37,8 @@ echo "🔨 Building WebAssembly..."
 mkdir -p build-wasm
 cd build-wasm
 
-# Use Emscripten's cmake and make wrappers
-emcmake cmake -DCMAKE_EXPORT_COMPILE_COMMANDS=ON ..
+# Use Emscripten's cmake and make wrappers (BTK_PROFILING=ON compiles in the engine profiler)
+emcmake cmake -DCMAKE_EXPORT_COMPILE_COMMANDS=ON -DBTK_PROFILING=${BTK_PROFILING:-OFF} ..
 emmake make VERBOSE=1 -j$(nproc)
 
 echo ""
@@ -50,7 +50,18 @@ if [[ "$1" == "-s" ]]; then
   echo ""
   echo "🌐 Starting web server on http://localhost:8001"
   cd web
-  python3 -m http.server 8001
+  # Same isolation headers as web/_headers, so the threaded build can load
+  python3 - <<'PYEOF'
+import http.server
+
+class Handler(http.server.SimpleHTTPRequestHandler):
+    def end_headers(self):
+        self.send_header('Cross-Origin-Opener-Policy', 'same-origin')
+        self.send_header('Cross-Origin-Embedder-Policy', 'credentialless')
+        super().end_headers()
+
+http.server.ThreadingHTTPServer(('', 8001), Handler).serve_forever()
+PYEOF
 else
   echo ""
   echo "💡 To start web server, run: $0 -s"
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "ballistics/bullet.h"
+#include "physics/atmosphere.h"
+#include <vector>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten/val.h>
+#endif
+
+namespace btk::ballistics
+{
+
+  /**
+   * @brief BC x muzzle velocity comparison grids at one range
+   *
+   * For every (BC, MV) cell the bullet is fired level from the origin and
+   * five values are taken where it crosses the range:
+   *   - drift in a full-value crosswind
+   *   - drop in still air
+   *   - MV sensitivity, the drop change over an MV_SPREAD spread of muzzle velocity
+   *   - velocity
+   *   - energy
+   * Angles are in mrad and unsigned. Each cell streams its trajectories
+   * (calm, crosswind, and MV -/+ half spread) without storing them, stopping
+   * at the range. Cells are independent, so natively and in pthread
+   * WebAssembly builds the grid is split across threads; other WebAssembly
+   * builds run on the calling thread.
+   *
+   * Grids are row-major, one row per BC and one column per MV.
+   */
+  class PerformanceMatrix
+  {
+    public:
+    /// Total muzzle velocity spread of the sensitivity grid (MV +/- 0.5%)
+    static constexpr float MV_SPREAD = 0.01f;
+
+    /**
+     * @brief Configure the grid
+     *
+     * @param bullet Bullet properties; its BC is replaced by each row's BC
+     * @param atmosphere Atmospheric conditions
+     * @param range Distance at which values are taken in m
+     * @param crosswind Crosswind speed of the drift grid in m/s
+     * @param timestep Integration time step in s
+     * @throws std::invalid_argument if range or timestep is not positive
+     */
+    PerformanceMatrix(const Bullet& bullet, const btk::physics::Atmosphere& atmosphere, float range, float crosswind, float timestep = 0.001f);
+
+    /**
+     * @brief Evaluate every cell of the grid
+     *
+     * @param bcs Ballistic coefficients (rows)
+     * @param bc_count Number of BCs
+     * @param mvs Muzzle velocities in m/s (columns)
+     * @param mv_count Number of MVs
+     * @param thread_count Worker threads (<= 0 uses the hardware concurrency)
+     * @throws std::invalid_argument if a BC or MV is not positive
+     */
+    void compute(const float* bcs, size_t bc_count, const float* mvs, size_t mv_count, int thread_count = 0);
+
+#ifdef __EMSCRIPTEN__
+    /**
+     * @brief compute() for JS: takes arrays of BCs and MVs (m/s)
+     */
+    void computeGrid(emscripten::val bcs_val, emscripten::val mvs_val, int thread_count);
+#endif
+
+    /// Number of BC rows of the last compute()
+    int getBcCount() const { return bc_count_; }
+
+    /// Number of MV columns of the last compute()
+    int getMvCount() const { return mv_count_; }
+
+    /**
+     * @brief Result grids, bc_count x mv_count floats each
+     *
+     * Return zero-copy Float32Array views; they are invalidated by compute().
+     */
+#ifdef __EMSCRIPTEN__
+    emscripten::val getDrift() const;       ///< Crosswind drift in mrad
+    emscripten::val getDrop() const;        ///< Drop in mrad
+    emscripten::val getSensitivity() const; ///< Drop change over MV_SPREAD in mrad
+    emscripten::val getVelocity() const;    ///< Velocity in m/s
+    emscripten::val getEnergy() const;      ///< Energy in J
+#else
+    const std::vector<float>& getDrift() const { return drift_; }
+    const std::vector<float>& getDrop() const { return drop_; }
+    const std::vector<float>& getSensitivity() const { return sensitivity_; }
+    const std::vector<float>& getVelocity() const { return velocity_; }
+    const std::vector<float>& getEnergy() const { return energy_; }
+#endif
+
+    private:
+    Bullet bullet_;
+    btk::physics::Atmosphere atmosphere_;
+    float range_;
+    float crosswind_;
+    float timestep_;
+    int bc_count_ = 0;
+    int mv_count_ = 0;
+
+    std::vector<float> drift_;
+    std::vector<float> drop_;
+    std::vector<float> sensitivity_;
+    std::vector<float> velocity_;
+    std::vector<float> energy_;
+  };
+
+} // namespace btk::ballistics
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "ballistics/bullet.h"
+#include "ballistics/simulator.h"
+#include "math/vector.h"
+#include "physics/atmosphere.h"
+#include <cstdint>
+#include <vector>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten/val.h>
+#endif
+
+namespace btk::ballistics
+{
+
+  /**
+   * @brief Dope table for a zeroed rifle: drop, windage, time, velocity and energy per range
+   *
+   * The rifle is zeroed once at construction (still air, line of sight level and
+   * scope_height above the bore). build() then streams the trajectory
+   * through the range schedule without storing it and writes each row as the
+   * bullet crosses that range, so a rebuild touches one buffer and no
+   * per-point objects. By default that is a single run in the given wind.
+   * The extended columns (windage and jump per mph, spin drift) are opt-in
+   * through setExtendedColumns(): they add a still-air run (skipped when the
+   * wind is calm) and a reference crosswind run.
+   *
+   * Rows are STRIDE floats laid out by the FIELD_* offsets. Linear values are
+   * in m relative to the line of sight, angles in the table's AngleUnit.
+   * Crosswind values are for wind blowing toward +X (from 9 o'clock); wind
+   * from the other side mirrors the windage and flips the jump.
+   */
+  class RangeTable
+  {
+    public:
+    /**
+     * @brief Unit of the angular columns
+     */
+    enum AngleUnit : uint8_t
+    {
+      MRAD = 0, // Milliradians
+      MOA = 1   // Minutes of angle
+    };
+
+    /// Field offsets of one row
+    static constexpr int FIELD_RANGE = 0;           // m
+    static constexpr int FIELD_DROP = 1;            // m, below (negative) or above the line of sight
+    static constexpr int FIELD_DROP_ANGLE = 2;      // Angle to hold or dial (negative = hold under)
+    static constexpr int FIELD_WINDAGE = 3;         // m, crossrange deflection in the given wind (includes spin drift)
+    static constexpr int FIELD_WINDAGE_ANGLE = 4;   // Angle of FIELD_WINDAGE
+    static constexpr int FIELD_WINDAGE_PER_MPH = 5; // Angle per mph of full-value crosswind (extended)
+    static constexpr int FIELD_SPIN_DRIFT = 6;      // Angle of spin drift in still air (extended)
+    static constexpr int FIELD_JUMP_PER_MPH = 7;    // Vertical angle per mph of full-value crosswind, aerodynamic jump (extended)
+    static constexpr int FIELD_TIME = 8;            // s, time of flight
+    static constexpr int FIELD_VELOCITY = 9;        // m/s
+    static constexpr int FIELD_ENERGY = 10;         // J
+    static constexpr int STRIDE = 11;               // Floats per row
+
+    /// Crosswind of the reference run, in mph (per-mph columns are scaled back from it)
+    static constexpr float REFERENCE_CROSSWIND_MPH = 10.0f;
+
+    /**
+     * @brief One row of the table
+     */
+    struct Row
+    {
+      float range_;           ///< m
+      float drop_;            ///< m
+      float drop_angle_;      ///< Table angle unit
+      float windage_;         ///< m
+      float windage_angle_;   ///< Table angle unit
+      float windage_per_mph_; ///< Table angle unit per mph
+      float spin_drift_;      ///< Table angle unit
+      float jump_per_mph_;    ///< Table angle unit per mph
+      float time_;            ///< s
+      float velocity_;        ///< m/s
+      float energy_;          ///< J
+
+      Row()
+        : range_(0.0f), drop_(0.0f), drop_angle_(0.0f), windage_(0.0f), windage_angle_(0.0f), windage_per_mph_(0.0f), spin_drift_(0.0f), jump_per_mph_(0.0f), time_(0.0f), velocity_(0.0f),
+          energy_(0.0f)
+      {
+      }
+    };
+
+    /**
+     * @brief Zero the rifle for the table
+     *
+     * @param bullet Bullet properties
+     * @param muzzle_velocity Muzzle velocity in m/s
+     * @param zero_range Zero distance in m
+     * @param scope_height Line of sight height above the bore in m
+     * @param atmosphere Atmospheric conditions
+     * @param wind Wind for the windage column in m/s (x=crossrange, y=vertical, z=-downrange)
+     * @param spin_rate Bullet spin rate in rad/s (0 disables spin drift and jump)
+     * @param unit Unit of the angular columns
+     * @param timestep Integration time step in s
+     * @throws std::invalid_argument if muzzle_velocity, zero_range or timestep is not positive
+     */
+    RangeTable(const Bullet& bullet, float muzzle_velocity, float zero_range, float scope_height, const btk::physics::Atmosphere& atmosphere, const btk::math::Vector3D& wind,
+               float spin_rate = 0.0f, AngleUnit unit = MRAD, float timestep = 0.001f);
+
+    /**
+     * @brief Fill the extended columns on the next build() (default off)
+     *
+     * FIELD_WINDAGE_PER_MPH, FIELD_SPIN_DRIFT and FIELD_JUMP_PER_MPH are NaN
+     * unless enabled. Enabling them costs one or two more trajectory runs per build().
+     */
+    void setExtendedColumns(bool enabled) { extended_columns_ = enabled; }
+
+    bool getExtendedColumns() const { return extended_columns_; }
+
+    /**
+     * @brief Build rows at 0, step, 2 * step, ... up to max_range
+     * @throws std::invalid_argument if step is not positive or max_range is negative
+     */
+    void build(float max_range, float step);
+
+    /**
+     * @brief Build rows at the given ranges
+     *
+     * Ranges beyond the reach of the bullet (max flight time 60 s) are left as NaN.
+     *
+     * @param ranges Ranges in m, ascending
+     * @param count Number of ranges
+     * @throws std::invalid_argument if the ranges are negative or not ascending
+     */
+    void buildAt(const float* ranges, size_t count);
+
+#ifdef __EMSCRIPTEN__
+    /**
+     * @brief buildAt() for JS: takes an array of ranges in m
+     */
+    void buildAt(emscripten::val ranges_val);
+#endif
+
+    /// Number of rows
+    int getRowCount() const { return static_cast<int>(data_.size() / STRIDE); }
+
+    /**
+     * @brief Get a row
+     * @throws std::invalid_argument if index is out of range
+     */
+    Row getRow(int index) const;
+
+    /**
+     * @brief Rows as STRIDE floats each
+     *
+     * Returns a zero-copy Float32Array view; it is invalidated by build().
+     */
+#ifdef __EMSCRIPTEN__
+    emscripten::val getData() const;
+#else
+    const std::vector<float>& getData() const { return data_; }
+#endif
+
+    /// Zeroed initial bullet (bore at the origin, line of sight at y = scope_height)
+    const Bullet& getZeroedBullet() const { return zeroed_bullet_; }
+
+    AngleUnit getAngleUnit() const { return unit_; }
+
+    private:
+    // Fill every row from the ranges already in data_
+    void fill();
+
+    // Stream one trajectory in the given wind; write(row, time, position, velocity) as it
+    // crosses each row's range. Returns the number of rows reached.
+    template <typename Write>
+    size_t run(const btk::math::Vector3D& wind, Write&& write);
+
+    // Angle subtended by offset_m at range_m, in the table unit
+    float toAngle(float offset_m, float range_m) const;
+
+    Simulator simulator_;
+    Bullet zeroed_bullet_;
+    btk::math::Vector3D wind_;
+    float scope_height_;
+    float timestep_;
+    AngleUnit unit_;
+    bool extended_columns_ = false;
+    std::vector<float> data_;
+  };
+
+} // namespace btk::ballistics
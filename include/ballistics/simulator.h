@@ -2,6 +2,7 @@
 
 #include "ballistics/bullet.h"
 #include "ballistics/trajectory.h"
+#include "ballistics/trajectory_observer.h"
 #include "math/conversions.h"
 #include "math/vector.h"
 #include "physics/atmosphere.h"
@@ -140,6 +141,60 @@ namespace btk::ballistics
      */
     void simulate(float max_distance, float dt, float max_time, const btk::physics::WindGenerator& wind_gen);
 
+    /**
+     * @brief Simulate trajectory with level-of-detail wind sampling
+     *
+     * Equivalent to the WindGenerator overload, but components frozen by the
+     * sampler are extrapolated instead of evaluated at every step.
+     *
+     * @param max_distance Maximum distance to simulate in m
+     * @param dt Time step for simulation in s
+     * @param max_time Maximum simulation time in s
+     * @param wind_sampler LOD wind sampler covering the trajectory region
+     */
+    void simulate(float max_distance, float dt, float max_time, const btk::physics::WindLodSampler& wind_sampler);
+
+    /**
+     * @brief Simulate trajectory, streaming points to an observer instead of storing them
+     *
+     * The observer receives the initial point and every step. Nothing is stored:
+     * the simulator's Trajectory is cleared and stays empty, so getTrajectory()
+     * does not describe this run. Returning false from the observer stops the
+     * simulation at that point (e.g. on first impact).
+     *
+     * @param max_distance Maximum distance to simulate in m
+     * @param dt Time step for simulation in s
+     * @param max_time Maximum simulation time in s
+     * @param observer Observer called per point
+     */
+    void simulate(float max_distance, float dt, float max_time, TrajectoryObserver& observer);
+
+    /**
+     * @brief Simulate trajectory with wind generator sampling, streaming points to an observer
+     *
+     * Clears the stored Trajectory like the constant-wind overload.
+     *
+     * @param max_distance Maximum distance to simulate in m
+     * @param dt Time step for simulation in s
+     * @param max_time Maximum simulation time in s
+     * @param wind_gen Wind generator for position/time-dependent wind
+     * @param observer Observer called per point
+     */
+    void simulate(float max_distance, float dt, float max_time, const btk::physics::WindGenerator& wind_gen, TrajectoryObserver& observer);
+
+    /**
+     * @brief Simulate trajectory with level-of-detail wind sampling, streaming points to an observer
+     *
+     * Clears the stored Trajectory like the constant-wind overload.
+     *
+     * @param max_distance Maximum distance to simulate in m
+     * @param dt Time step for simulation in s
+     * @param max_time Maximum simulation time in s
+     * @param wind_sampler LOD wind sampler covering the trajectory region
+     * @param observer Observer called per point
+     */
+    void simulate(float max_distance, float dt, float max_time, const btk::physics::WindLodSampler& wind_sampler, TrajectoryObserver& observer);
+
     /**
      * @brief Advance simulation by one time step
      *
@@ -188,6 +243,14 @@ namespace btk::ballistics
     btk::math::Vector3D calculateAccelerationFor(Bullet& s, float dt);
     btk::math::Vector3D computeSpinWindAccel(Bullet& s, const btk::math::Vector3D& gravity, const btk::math::Vector3D& wind, float dt);
 
+    // Advance current state by one RK2 step without recording
+    void integrateStep(float dt);
+
+    // Shared integration loop: wind_field(x, y, z) supplies wind before each step,
+    // sink(time, bullet, wind) receives each point and returns false to stop
+    template <typename WindField, typename PointSink>
+    void simulateInWindField(float max_distance, float dt, float max_time, const WindField& wind_field, PointSink&& sink);
+
     // Internal state
     Bullet initial_bullet_;
     Bullet current_bullet_;
@@ -6,6 +6,10 @@
 #include <optional>
 #include <vector>
 
+#ifdef __EMSCRIPTEN__
+#include <emscripten/val.h>
+#endif
+
 namespace btk::ballistics
 {
 
@@ -72,6 +76,18 @@ namespace btk::ballistics
   class Trajectory
   {
     public:
+    /// Field offsets of one record written by sampleAtDistances / sampleAtTimes
+    static constexpr int SAMPLE_TIME = 0;     // s
+    static constexpr int SAMPLE_X = 1;        // m, crossrange
+    static constexpr int SAMPLE_Y = 2;        // m, vertical
+    static constexpr int SAMPLE_Z = 3;        // m, -downrange
+    static constexpr int SAMPLE_VX = 4;       // m/s
+    static constexpr int SAMPLE_VY = 5;       // m/s
+    static constexpr int SAMPLE_VZ = 6;       // m/s
+    static constexpr int SAMPLE_VELOCITY = 7; // m/s, total
+    static constexpr int SAMPLE_ENERGY = 8;   // J
+    static constexpr int SAMPLE_STRIDE = 9;   // Floats per record
+
     /**
      * @brief Initialize empty trajectory
      */
@@ -121,6 +137,51 @@ namespace btk::ballistics
      */
     std::optional<TrajectoryPoint> atTime(float time) const;
 
+    /**
+     * @brief Sample the trajectory at many distances in one call
+     *
+     * Writes one SAMPLE_STRIDE record (see SAMPLE_TIME ... SAMPLE_ENERGY) per distance, with the
+     * same interpolation and end clamping as atDistance(). Ascending distances
+     * are walked in a single pass; unsorted input is allowed but slower. An
+     * empty trajectory yields NaN records.
+     *
+     * @param distances Distances along trajectory in m
+     * @param count Number of distances
+     * @param out Output, count * SAMPLE_STRIDE floats
+     */
+    void sampleAtDistances(const float* distances, size_t count, float* out) const;
+
+    /**
+     * @brief Sample the trajectory at many times in one call
+     *
+     * Same record layout as sampleAtDistances(), interpolated like atTime().
+     *
+     * @param times Times along trajectory in s
+     * @param count Number of times
+     * @param out Output, count * SAMPLE_STRIDE floats
+     */
+    void sampleAtTimes(const float* times, size_t count, float* out) const;
+
+#ifdef __EMSCRIPTEN__
+    /**
+     * @brief sampleAtDistances() for JS: takes an array of distances, returns a Float32Array of records
+     */
+    emscripten::val sampleAtDistances(emscripten::val distances_val) const;
+
+    /**
+     * @brief sampleAtTimes() for JS: takes an array of times, returns a Float32Array of records
+     */
+    emscripten::val sampleAtTimes(emscripten::val times_val) const;
+#endif
+
+    /**
+     * @brief Write a trajectory point as one SAMPLE_STRIDE record
+     *
+     * @param point Point to convert
+     * @param out Record to fill, SAMPLE_STRIDE floats
+     */
+    static void writeSample(const TrajectoryPoint& point, float* out);
+
     /**
      * @brief Get the total distance of the trajectory
      */
@@ -216,6 +277,16 @@ namespace btk::ballistics
      * @return Interpolated flying bullet state
      */
     Bullet interpolate(const TrajectoryPoint& point1, const TrajectoryPoint& point2, float distance) const;
+
+    /**
+     * @brief Write one sample record between points_[left] and points_[left + 1]
+     *
+     * @param left Index of the first point of the segment
+     * @param t Interpolation factor in [0, 1]
+     * @param time Time of the sample in s
+     * @param out Record to fill, SAMPLE_STRIDE floats
+     */
+    void writeSample(size_t left, float t, float time, float* out) const;
   };
 
 } // namespace btk::ballistics
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "ballistics/trajectory.h"
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten/val.h>
+#endif
+
+namespace btk::ballistics
+{
+
+  /**
+   * @brief Receives trajectory points while the simulator integrates
+   *
+   * Passed to the streaming Simulator::simulate overloads, which do not store
+   * points in the simulator's Trajectory.
+   *
+   * JS can implement one with TrajectoryObserver.extend("Name", { onPoint(point) { ... } }).
+   * Each point is a copy the callback must delete(); a JS call per step is slow,
+   * so prefer StationRecorder when only some points are needed.
+   */
+  class TrajectoryObserver
+  {
+    public:
+    virtual ~TrajectoryObserver() = default;
+
+    /**
+     * @brief Called with the initial point and after every integration step
+     *
+     * @param point Current trajectory point
+     * @return True to continue, false to stop the simulation after this point
+     */
+    virtual bool onPoint(const TrajectoryPoint& point) = 0;
+  };
+
+  /**
+   * @brief Adapts any callable bool(const TrajectoryPoint&) to a TrajectoryObserver
+   */
+  template <typename Callback>
+  class CallbackObserver : public TrajectoryObserver
+  {
+    public:
+    explicit CallbackObserver(Callback callback) : callback_(std::move(callback)) {}
+
+    bool onPoint(const TrajectoryPoint& point) override { return callback_(point); }
+
+    private:
+    Callback callback_;
+  };
+
+  /**
+   * @brief Build a CallbackObserver from a lambda or functor
+   */
+  template <typename Callback>
+  CallbackObserver<Callback> makeObserver(Callback callback)
+  {
+    return CallbackObserver<Callback>(std::move(callback));
+  }
+
+  /**
+   * @brief Records interpolated points at requested distance or time stations
+   *
+   * Keeps only the previous step, interpolates each station as the trajectory
+   * crosses it (same interpolation as Trajectory::atDistance/atTime) and stops
+   * the simulation once the last station has been recorded.
+   */
+  class StationRecorder : public TrajectoryObserver
+  {
+    public:
+    /**
+     * @brief Station axis
+     */
+    enum StationType : uint8_t
+    {
+      DISTANCE = 0, // Stations are downrange distances in m
+      TIME = 1      // Stations are times of flight in s
+    };
+
+    /**
+     * @brief Construct recorder with no stations
+     *
+     * @param type Station axis
+     */
+    explicit StationRecorder(StationType type = DISTANCE);
+
+    /**
+     * @brief Construct recorder for a list of stations
+     *
+     * @param stations Station values (sorted internally)
+     * @param type Station axis
+     */
+    StationRecorder(std::vector<float> stations, StationType type = DISTANCE);
+
+    /**
+     * @brief Add a station (must be called before simulating)
+     *
+     * @param station Distance in m or time in s
+     */
+    void addStation(float station);
+
+    /**
+     * @brief Discard recorded points so the recorder can observe another trajectory
+     */
+    void reset();
+
+    bool onPoint(const TrajectoryPoint& point) override;
+
+    /**
+     * @brief Get recorded points, one per station reached, in station order
+     */
+    const std::vector<TrajectoryPoint>& getPoints() const { return points_; }
+
+    /**
+     * @brief Write the recorded points as Trajectory sample records
+     *
+     * Same layout as Trajectory::sampleAtDistances(): one Trajectory::SAMPLE_STRIDE
+     * record per recorded point, in station order.
+     *
+     * @param out Output, getPoints().size() * Trajectory::SAMPLE_STRIDE floats
+     */
+    void getSamples(float* out) const;
+
+#ifdef __EMSCRIPTEN__
+    /**
+     * @brief getSamples() for JS: returns a Float32Array of records (a copy)
+     */
+    emscripten::val getSamples() const;
+#endif
+
+    /**
+     * @brief Check whether every station has been recorded
+     */
+    bool isComplete() const { return points_.size() == stations_.size(); }
+
+    private:
+    // Station coordinate of a point on the recorder's axis
+    float stationValue(const TrajectoryPoint& point) const;
+
+    StationType type_;
+    std::vector<float> stations_;
+    std::vector<TrajectoryPoint> points_;
+    std::optional<TrajectoryPoint> previous_;
+  };
+
+} // namespace btk::ballistics
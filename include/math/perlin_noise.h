@@ -1,10 +1,13 @@
 #pragma once
 
 #include "math/random.h"
+#include "math/simd.h"
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 namespace btk::math
 {
@@ -93,6 +96,104 @@ namespace btk::math
       return lerp(y1, y2, w);
     }
 
+    /**
+     * @brief Evaluate noise3D() on every lane of a SIMD vector
+     *
+     * Lattice hashing is gathered per lane; fade, gradient dot products and the
+     * trilinear blend run on full vectors. Matches noise3D() to within 1e-6 absolute.
+     *
+     * @tparam VF Float lane type (simd::vfloat4 or simd::vfloat8)
+     * @tparam VI Matching int lane type (simd::vint4 or simd::vint8)
+     */
+    template <typename VF, typename VI>
+    inline VF noise3DLanes(VF x, VF y, VF z) const noexcept
+    {
+      constexpr int LANES = sizeof(VF) / sizeof(float);
+      VI fx = simd::floorToInt<VI>(x);
+      VI fy = simd::floorToInt<VI>(y);
+      VI fz = simd::floorToInt<VI>(z);
+      VI X = fx & 255;
+      VI Y = fy & 255;
+      VI Z = fz & 255;
+      VF xf = x - simd::toFloat<VF>(fx);
+      VF yf = y - simd::toFloat<VF>(fy);
+      VF zf = z - simd::toFloat<VF>(fz);
+      VF u = fade(xf);
+      VF v = fade(yf);
+      VF w = fade(zf);
+
+      // Per-lane hash of the 8 cube corners into gradient components
+      // Corner order: AA, BA, AB, BB, AA+1, BA+1, AB+1, BB+1
+      VF gx[8] = {}, gy[8] = {}, gz[8] = {};
+      for(int l = 0; l < LANES; ++l)
+      {
+        int A = perm_[X[l]] + Y[l];
+        int B = perm_[X[l] + 1] + Y[l];
+        int AA = perm_[A] + Z[l];
+        int AB = perm_[A + 1] + Z[l];
+        int BA = perm_[B] + Z[l];
+        int BB = perm_[B + 1] + Z[l];
+        const int h[8] = {perm_[AA], perm_[BA], perm_[AB], perm_[BB], perm_[AA + 1], perm_[BA + 1], perm_[AB + 1], perm_[BB + 1]};
+        for(int c = 0; c < 8; ++c)
+        {
+          const int* g = grad3_[h[c] % 12];
+          gx[c][l] = g[0];
+          gy[c][l] = g[1];
+          gz[c][l] = g[2];
+        }
+      }
+
+      VF xm = xf - 1;
+      VF ym = yf - 1;
+      VF zm = zf - 1;
+      VF x1 = lerp(gx[0] * xf + gy[0] * yf + gz[0] * zf, gx[1] * xm + gy[1] * yf + gz[1] * zf, u);
+      VF x2 = lerp(gx[2] * xf + gy[2] * ym + gz[2] * zf, gx[3] * xm + gy[3] * ym + gz[3] * zf, u);
+      VF y1 = lerp(x1, x2, v);
+
+      VF x3 = lerp(gx[4] * xf + gy[4] * yf + gz[4] * zm, gx[5] * xm + gy[5] * yf + gz[5] * zm, u);
+      VF x4 = lerp(gx[6] * xf + gy[6] * ym + gz[6] * zm, gx[7] * xm + gy[7] * ym + gz[7] * zm, u);
+      VF y2 = lerp(x3, x4, v);
+
+      return lerp(y1, y2, w);
+    }
+
+    /**
+     * @brief Evaluate noise3D() for a batch of points
+     *
+     * Processes simd::NATIVE_WIDTH points per kernel call; a partial tail is padded.
+     *
+     * @param x X coordinates
+     * @param y Y coordinates
+     * @param z Z coordinates
+     * @param out Output noise values (may not alias inputs)
+     * @param count Number of points
+     */
+    inline void noise3D(const float* x, const float* y, const float* z, float* out, size_t count) const noexcept
+    {
+      constexpr size_t W = simd::NATIVE_WIDTH;
+      size_t n = 0;
+      for(; n + W <= count; n += W)
+      {
+        simd::vfloat vx, vy, vz;
+        std::memcpy(&vx, x + n, sizeof(vx));
+        std::memcpy(&vy, y + n, sizeof(vy));
+        std::memcpy(&vz, z + n, sizeof(vz));
+        simd::vfloat r = noise3DLanes<simd::vfloat, simd::vint>(vx, vy, vz);
+        std::memcpy(out + n, &r, sizeof(r));
+      }
+
+      if(n < count)
+      {
+        const size_t rem = count - n;
+        simd::vfloat vx{}, vy{}, vz{};
+        std::memcpy(&vx, x + n, rem * sizeof(float));
+        std::memcpy(&vy, y + n, rem * sizeof(float));
+        std::memcpy(&vz, z + n, rem * sizeof(float));
+        simd::vfloat r = noise3DLanes<simd::vfloat, simd::vint>(vx, vy, vz);
+        std::memcpy(out + n, &r, rem * sizeof(float));
+      }
+    }
+
     inline float noise4D(float x, float y, float z, float w) const noexcept
     {
       int X = static_cast<int>(std::floor(x)) & 255;
@@ -165,9 +266,21 @@ namespace btk::math
     private:
     std::array<int, 512> perm_{};
 
-    static inline float fade(float t) noexcept { return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f); }
+    // 3D gradient table shared by the scalar (grad3) and lane kernels
+    static constexpr int grad3_[12][3] = {{1, 1, 0}, {-1, 1, 0}, {1, -1, 0}, {-1, -1, 0}, {1, 0, 1}, {-1, 0, 1}, {1, 0, -1}, {-1, 0, -1}, {0, 1, 1}, {0, -1, 1}, {0, 1, -1}, {0, -1, -1}};
 
-    static inline float lerp(float a, float b, float t) noexcept { return a + (b - a) * t; }
+    // fade() and lerp() are shared by the scalar and lane kernels (T = float or a SIMD float vector)
+    template <typename T>
+    static inline T fade(T t) noexcept
+    {
+      return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+    }
+
+    template <typename T>
+    static inline T lerp(T a, T b, T t) noexcept
+    {
+      return a + (b - a) * t;
+    }
 
     static inline float grad1(int h, float x) noexcept { return (h & 1) ? -x : x; }
 
@@ -188,8 +301,7 @@ namespace btk::math
 
     static inline float grad3(int h, float x, float y, float z) noexcept
     {
-      static constexpr int g[12][3] = {{1, 1, 0}, {-1, 1, 0}, {1, -1, 0}, {-1, -1, 0}, {1, 0, 1}, {-1, 0, 1}, {1, 0, -1}, {-1, 0, -1}, {0, 1, 1}, {0, -1, 1}, {0, 1, -1}, {0, -1, -1}};
-      const int* v = g[h % 12];
+      const int* v = grad3_[h % 12];
       return v[0] * x + v[1] * y + v[2] * z;
     }
 
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+
+namespace btk::math::simd
+{
+  // Portable SIMD lanes built on GCC/Clang vector extensions. The compiler lowers
+  // these to SSE/AVX2 natively and to SIMD128 under Emscripten with -msimd128;
+  // without SIMD support they are scalarised, so results stay identical.
+
+  typedef float vfloat4 __attribute__((vector_size(16)));
+  typedef int32_t vint4 __attribute__((vector_size(16)));
+  typedef float vfloat8 __attribute__((vector_size(32)));
+  typedef int32_t vint8 __attribute__((vector_size(32)));
+
+  // Widest lane count the target handles natively (used by batch APIs)
+#if defined(__AVX2__)
+  constexpr int NATIVE_WIDTH = 8;
+  typedef vfloat8 vfloat;
+  typedef vint8 vint;
+#else
+  constexpr int NATIVE_WIDTH = 4;
+  typedef vfloat4 vfloat;
+  typedef vint4 vint;
+#endif
+
+  /**
+   * @brief Broadcast a scalar to all lanes
+   */
+  template <typename V, typename S>
+  inline V splat(S value) noexcept
+  {
+    return V{} + value;
+  }
+
+  /**
+   * @brief Lane-wise select: mask ? a : b (mask lanes are all-ones or zero, as produced by comparisons)
+   */
+  template <typename VF, typename VI>
+  inline VF select(VI mask, VF a, VF b) noexcept
+  {
+    return reinterpret_cast<VF>((reinterpret_cast<VI>(a) & mask) | (reinterpret_cast<VI>(b) & ~mask));
+  }
+
+  /**
+   * @brief Convert float lanes to int lanes (truncation toward zero)
+   */
+  template <typename VI, typename VF>
+  inline VI toInt(VF v) noexcept
+  {
+    return __builtin_convertvector(v, VI);
+  }
+
+  /**
+   * @brief Convert int lanes to float lanes
+   */
+  template <typename VF, typename VI>
+  inline VF toFloat(VI v) noexcept
+  {
+    return __builtin_convertvector(v, VF);
+  }
+
+  /**
+   * @brief Lane-wise floor returning int lanes (matches static_cast<int>(std::floor(x)))
+   */
+  template <typename VI, typename VF>
+  inline VI floorToInt(VF v) noexcept
+  {
+    VI t = toInt<VI>(v);
+    // Comparison masks are -1 where true, so adding subtracts one where truncation rounded up
+    return t + (v < toFloat<VF>(t));
+  }
+
+} // namespace btk::math::simd
@@ -1,9 +1,12 @@
 #pragma once
 
 #include "math/random.h"
+#include "math/simd.h"
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstring>
 
 namespace btk::math
 {
@@ -261,6 +264,124 @@ namespace btk::math
       return 32.0f * (n0 + n1 + n2 + n3);
     }
 
+    /**
+     * @brief Evaluate noise3D() on every lane of a SIMD vector
+     *
+     * Branch-free variant of the scalar kernel: simplex corner ordering is derived
+     * from comparison masks, out-of-range contributions are masked instead of
+     * skipped, and permutation lookups are gathered per lane. Lane results match
+     * noise3D() to within 1e-6 absolute. If the compiler contracts the two paths
+     * differently (FMA), a point within rounding of a simplex cell boundary may
+     * land in the neighbouring cell; the 0.6 kernel radius is not continuous
+     * there, so such points can differ by up to ~5e-3.
+     *
+     * @tparam VF Float lane type (simd::vfloat4 or simd::vfloat8)
+     * @tparam VI Matching int lane type (simd::vint4 or simd::vint8)
+     */
+    template <typename VF, typename VI>
+    inline VF noise3DLanes(VF x, VF y, VF z) const noexcept
+    {
+      constexpr int LANES = sizeof(VF) / sizeof(float);
+      x += offset_x_;
+      y += offset_y_;
+      z += offset_z_;
+      const float F3 = 1.0f / 3.0f;
+      const float G3 = 1.0f / 6.0f;
+
+      VF s = (x + y + z) * F3;
+      VI i = fastfloorLanes<VI>(x + s);
+      VI j = fastfloorLanes<VI>(y + s);
+      VI k = fastfloorLanes<VI>(z + s);
+
+      VF t = simd::toFloat<VF>(i + j + k) * G3;
+      VF x0 = x - (simd::toFloat<VF>(i) - t);
+      VF y0 = y - (simd::toFloat<VF>(j) - t);
+      VF z0 = z - (simd::toFloat<VF>(k) - t);
+
+      // Simplex corner offsets from comparison masks (all-ones = true); negate to get 0/1
+      VI ge_xy = x0 >= y0;
+      VI ge_yz = y0 >= z0;
+      VI ge_xz = x0 >= z0;
+      VI i1 = -(ge_xy & ge_xz);
+      VI j1 = -(~ge_xy & ge_yz);
+      VI k1 = -(~ge_xz & ~ge_yz);
+      VI i2 = -(ge_xy | ge_xz);
+      VI j2 = -(~ge_xy | ge_yz);
+      VI k2 = -(~ge_xz | ~ge_yz);
+
+      VF x1 = x0 - simd::toFloat<VF>(i1) + G3;
+      VF y1 = y0 - simd::toFloat<VF>(j1) + G3;
+      VF z1 = z0 - simd::toFloat<VF>(k1) + G3;
+      VF x2 = x0 - simd::toFloat<VF>(i2) + 2.0f * G3;
+      VF y2 = y0 - simd::toFloat<VF>(j2) + 2.0f * G3;
+      VF z2 = z0 - simd::toFloat<VF>(k2) + 2.0f * G3;
+      VF x3 = x0 - 1.0f + 3.0f * G3;
+      VF y3 = y0 - 1.0f + 3.0f * G3;
+      VF z3 = z0 - 1.0f + 3.0f * G3;
+
+      i &= 255;
+      j &= 255;
+      k &= 255;
+
+      // Per-lane permutation gather into gradient components for the four corners
+      VF gx[4] = {}, gy[4] = {}, gz[4] = {};
+      for(int l = 0; l < LANES; ++l)
+      {
+        const int gi[4] = {perm_[i[l] + perm_[j[l] + perm_[k[l]]]] % 12, perm_[i[l] + i1[l] + perm_[j[l] + j1[l] + perm_[k[l] + k1[l]]]] % 12,
+                           perm_[i[l] + i2[l] + perm_[j[l] + j2[l] + perm_[k[l] + k2[l]]]] % 12, perm_[i[l] + 1 + perm_[j[l] + 1 + perm_[k[l] + 1]]] % 12};
+        for(int c = 0; c < 4; ++c)
+        {
+          gx[c][l] = grad3_[gi[c]][0];
+          gy[c][l] = grad3_[gi[c]][1];
+          gz[c][l] = grad3_[gi[c]][2];
+        }
+      }
+
+      VF n0 = contribution3Lanes<VF, VI>(x0, y0, z0, gx[0], gy[0], gz[0]);
+      VF n1 = contribution3Lanes<VF, VI>(x1, y1, z1, gx[1], gy[1], gz[1]);
+      VF n2 = contribution3Lanes<VF, VI>(x2, y2, z2, gx[2], gy[2], gz[2]);
+      VF n3 = contribution3Lanes<VF, VI>(x3, y3, z3, gx[3], gy[3], gz[3]);
+
+      return 32.0f * (n0 + n1 + n2 + n3);
+    }
+
+    /**
+     * @brief Evaluate noise3D() for a batch of points
+     *
+     * Processes simd::NATIVE_WIDTH points per kernel call; a partial tail is padded.
+     *
+     * @param x X coordinates
+     * @param y Y coordinates
+     * @param z Z coordinates
+     * @param out Output noise values (may not alias inputs)
+     * @param count Number of points
+     */
+    inline void noise3D(const float* x, const float* y, const float* z, float* out, size_t count) const noexcept
+    {
+      constexpr size_t W = simd::NATIVE_WIDTH;
+      size_t n = 0;
+      for(; n + W <= count; n += W)
+      {
+        simd::vfloat vx, vy, vz;
+        std::memcpy(&vx, x + n, sizeof(vx));
+        std::memcpy(&vy, y + n, sizeof(vy));
+        std::memcpy(&vz, z + n, sizeof(vz));
+        simd::vfloat r = noise3DLanes<simd::vfloat, simd::vint>(vx, vy, vz);
+        std::memcpy(out + n, &r, sizeof(r));
+      }
+
+      if(n < count)
+      {
+        const size_t rem = count - n;
+        simd::vfloat vx{}, vy{}, vz{};
+        std::memcpy(&vx, x + n, rem * sizeof(float));
+        std::memcpy(&vy, y + n, rem * sizeof(float));
+        std::memcpy(&vz, z + n, rem * sizeof(float));
+        simd::vfloat r = noise3DLanes<simd::vfloat, simd::vint>(vx, vy, vz);
+        std::memcpy(out + n, &r, rem * sizeof(float));
+      }
+    }
+
     inline float noise4D(float x, float y, float z, float w) const noexcept
     {
       x += offset_x_;
@@ -451,6 +572,23 @@ namespace btk::math
 
     static inline int fastfloor(float x) noexcept { return x > 0 ? static_cast<int>(x) : static_cast<int>(x) - 1; }
 
+    // Lane-wise fastfloor(): comparison mask is -1 where x > 0, cancelling the -1
+    template <typename VI, typename VF>
+    static inline VI fastfloorLanes(VF x) noexcept
+    {
+      return simd::toInt<VI>(x) - 1 - (x > 0.0f);
+    }
+
+    // Masked corner contribution: t^4 * dot(g, p) where t = 0.6 - |p|^2 >= 0, else 0
+    template <typename VF, typename VI>
+    static inline VF contribution3Lanes(VF x, VF y, VF z, VF gx, VF gy, VF gz) noexcept
+    {
+      VF t = 0.6f - x * x - y * y - z * z;
+      VF t2 = t * t;
+      VF n = t2 * t2 * (gx * x + gy * y + gz * z);
+      return simd::select<VF, VI>(t >= 0.0f, n, VF{});
+    }
+
     static inline float dot1(int g, float x) noexcept { return g * x; }
 
     static inline float dot2(const int* g, float x, float y) noexcept { return g[0] * x + g[1] * y; }
@@ -2,14 +2,29 @@
 
 #include "math/simplex_noise.h"
 #include "math/vector.h"
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <string>
 #include <vector>
 
+#ifdef __EMSCRIPTEN__
+#include <emscripten/val.h>
+#endif
+
 namespace btk::physics
 {
 
+  /**
+   * @brief Vertical wind shear profiles for the atmospheric boundary layer
+   */
+  enum WindShearProfile : uint8_t
+  {
+    UNIFORM = 0,     // Same wind at every height (default)
+    LOGARITHMIC = 1, // u(h) ~ ln(h / z0), zero at the roughness length
+    POWER_LAW = 2    // u(h) ~ h^alpha
+  };
+
   /**
    * @brief Wind generator for position and time-dependent wind
    */
@@ -31,9 +46,9 @@ namespace btk::physics
     /**
      * @brief Sample wind at given position using current internal time
      *
-     * @param x_m Downrange position in meters
-     * @param y_m Crossrange position in meters
-     * @param z_m Vertical position in meters (ignored - no altitude variation)
+     * @param x_m Crossrange position in meters
+     * @param y_m Vertical position in meters, relative to the muzzle (only scales the wind through the shear profile)
+     * @param z_m Downrange position in meters (negative downrange)
      * @return Wind vector (m/s) in BTK coordinates: (x=crosswind, y=vertical, z=-headwind)
      */
     btk::math::Vector3D operator()(float x_m, float y_m, float z_m) const;
@@ -41,7 +56,7 @@ namespace btk::physics
     /**
      * @brief Sample wind at a specific location using Vector3D
      *
-     * @param pos Position vector (x=downrange, y=crossrange, z=height) in meters
+     * @param pos Position vector in BTK coordinates (x=crossrange, y=vertical from the muzzle, z=-downrange) in meters
      * @return Wind vector (m/s) in BTK coordinates: (x=crosswind, y=vertical, z=-headwind)
      */
     btk::math::Vector3D operator()(const btk::math::Vector3D& pos) const;
@@ -49,9 +64,9 @@ namespace btk::physics
     /**
      * @brief Sample wind at a specific location
      *
-     * @param x_m X coordinate in meters (downrange)
-     * @param y_m Y coordinate in meters (crossrange, positive = right)
-     * @param z_m Z coordinate in meters (height)
+     * @param x_m X coordinate in meters (crossrange, positive = right)
+     * @param y_m Y coordinate in meters (vertical, relative to the muzzle)
+     * @param z_m Z coordinate in meters (negative downrange)
      * @return Wind vector (m/s) in BTK coordinates: (x=crosswind, y=vertical, z=-headwind)
      */
     btk::math::Vector3D sample(float x_m, float y_m, float z_m) const;
@@ -59,7 +74,7 @@ namespace btk::physics
     /**
      * @brief Sample wind at a specific location using Vector3D
      *
-     * @param pos Position vector (x=downrange, y=crossrange, z=height) in meters
+     * @param pos Position vector in BTK coordinates (x=crossrange, y=vertical from the muzzle, z=-downrange) in meters
      * @return Wind vector (m/s) in BTK coordinates: (x=crosswind, y=vertical, z=-headwind)
      */
     btk::math::Vector3D sample(const btk::math::Vector3D& pos) const;
@@ -93,6 +108,59 @@ namespace btk::physics
      */
     void setAdvectionAlpha(float alpha);
 
+    /**
+     * @brief Set the vertical wind shear profile
+     *
+     * The noise field defines the wind at the reference height; samples at other
+     * heights are scaled by the profile factor, read from a table precomputed here
+     * so sampling cost does not change. Trajectory y is measured from the bore, so
+     * the profile is evaluated at y + the muzzle height (see setMuzzleHeight());
+     * heights above ground are clamped to [0, SHEAR_TABLE_MAX_HEIGHT].
+     *
+     * @param profile Shear profile (UNIFORM disables shear)
+     * @param reference_height_m Height at which the field has its nominal strength (m)
+     * @param roughness_length_m Surface roughness length z0 for LOGARITHMIC (m, e.g. 0.03 for short grass)
+     * @param power_law_exponent Exponent alpha for POWER_LAW (e.g. 1/7 for open terrain)
+     */
+    void setShearProfile(WindShearProfile profile, float reference_height_m = DEFAULT_SHEAR_REFERENCE_HEIGHT, float roughness_length_m = DEFAULT_ROUGHNESS_LENGTH,
+                         float power_law_exponent = DEFAULT_POWER_LAW_EXPONENT);
+
+    /**
+     * @brief Get the vertical wind shear profile
+     */
+    WindShearProfile getShearProfile() const { return shear_profile_; }
+
+    /**
+     * @brief Get the wind multiplier applied at a height
+     *
+     * @param height_m Height above ground in meters
+     * @return Multiplier relative to the reference height (1 for UNIFORM)
+     */
+    float getShearFactor(float height_m) const;
+
+    /**
+     * @brief Set the height of the muzzle above ground
+     *
+     * Sampled positions are relative to the muzzle (y = 0 at the bore), while the
+     * shear profile is defined above ground; this offset converts between them.
+     *
+     * @param muzzle_height_m Muzzle height above ground in meters (e.g. 0.3 prone, 1.0 bench)
+     * @throws std::invalid_argument if muzzle_height_m is negative
+     */
+    void setMuzzleHeight(float muzzle_height_m);
+
+    /**
+     * @brief Get the height of the muzzle above ground in meters
+     */
+    float getMuzzleHeight() const { return muzzle_height_m_; }
+
+    static constexpr float DEFAULT_SHEAR_REFERENCE_HEIGHT = 2.0f; // m, roughly where a shooter reads the flags
+    static constexpr float DEFAULT_ROUGHNESS_LENGTH = 0.03f;      // m, open short grass
+    static constexpr float DEFAULT_POWER_LAW_EXPONENT = 1.0f / 7.0f;
+    static constexpr float DEFAULT_MUZZLE_HEIGHT = 1.0f;    // m, bench or supported standing position
+    static constexpr float SHEAR_TABLE_MAX_HEIGHT = 200.0f; // m, shear is held constant above this
+    static constexpr int SHEAR_TABLE_SIZE = 801;            // 0.25 m spacing
+
     /**
      * @brief Add a wind component octave
      *
@@ -194,10 +262,52 @@ namespace btk::physics
      *
      * @param octave_index Component index (0 to NUM_OCTAVES-1)
      * @param position Position to sample at (x, y, z)
-     * @return Wind vector from this component only
+     * @return Wind vector from this component only, at the shear reference height
      */
     btk::math::Vector3D sampleComponent(int octave_index, const btk::math::Vector3D& position) const;
 
+    /**
+     * @brief Rasterise the current wind field over a horizontal rectangle
+     *
+     * Samples cell centers of a width x height grid: column c maps to
+     * x = min.x + (c + 0.5) * (max.x - min.x) / width and row r to
+     * z = min.z + (r + 0.5) * (max.z - min.z) / height, at height min.y.
+     * Corners need not be ordered, so rows can run toward or away from the shooter.
+     * Large-scale components are frozen over the rectangle (see WindLodSampler).
+     *
+     * @param out Output buffer of width * height * 2 floats, row-major, RG = (x=crosswind, z=-headwind) in m/s
+     * @param width Number of crossrange columns
+     * @param height Number of downrange rows
+     * @param min_corner First corner of the rectangle (x=crossrange, y=height, z=-downrange) in m
+     * @param max_corner Opposite corner of the rectangle (x=crossrange, z=-downrange) in m
+     */
+    void rasterize(float* out, int width, int height, const btk::math::Vector3D& min_corner, const btk::math::Vector3D& max_corner) const;
+
+    /**
+     * @brief Rasterise the current wind field into the internal field texture
+     *
+     * Same layout as rasterize(); the buffer is reused across calls of the same size.
+     *
+     * @param width Number of crossrange columns
+     * @param height Number of downrange rows
+     * @param min_corner First corner of the rectangle (x=crossrange, y=height, z=-downrange) in m
+     * @param max_corner Opposite corner of the rectangle (x=crossrange, z=-downrange) in m
+     */
+    void updateFieldTexture(int width, int height, const btk::math::Vector3D& min_corner, const btk::math::Vector3D& max_corner);
+
+    /**
+     * @brief Get field texture buffer (RG float32, width * height * 2)
+     * Returns a Float32Array view into WASM memory (zero-copy); invalidated by the next resize
+     */
+#ifdef __EMSCRIPTEN__
+    emscripten::val getFieldTexture() const;
+#else
+    const std::vector<float>& getFieldTexture() const { return field_texture_; }
+#endif
+
+    int getFieldTextureWidth() const { return field_texture_width_; }
+    int getFieldTextureHeight() const { return field_texture_height_; }
+
     private:
     // Compute raw curl vector (curl_x, curl_y) at a specific position and time
     btk::math::Vector3D computeCurl(int octave_index, const btk::math::Vector3D& position, float time) const;
@@ -228,6 +338,103 @@ namespace btk::physics
     btk::math::Vector3D global_advection_velocity_; // EMA-smoothed global velocity
 
     std::vector<WindComponent> components_;
+
+    WindShearProfile shear_profile_ = UNIFORM;
+    std::vector<float> shear_table_;                // Profile factor at SHEAR_TABLE_SIZE evenly spaced heights (empty when UNIFORM)
+    float muzzle_height_m_ = DEFAULT_MUZZLE_HEIGHT; // Ground height offset of sampled y
+
+    std::vector<float> field_texture_; // RG float32 wind field raster (see updateFieldTexture)
+    int field_texture_width_ = 0;
+    int field_texture_height_ = 0;
+  };
+
+  /**
+   * @brief Level-of-detail view of a WindGenerator over a bounded region and time horizon
+   *
+   * Components whose spatial and temporal scales are large compared to the region
+   * (e.g. the 10,000 yd / 15 min base) barely change across it. Those components are
+   * evaluated once at the region center, together with their horizontal gradient,
+   * and linearly extrapolated for every sample. Remaining components are sampled
+   * per call exactly like WindGenerator::sample().
+   *
+   * The sampler holds a non-owning pointer to the generator, which must outlive it.
+   */
+  class WindLodSampler
+  {
+    public:
+    /**
+     * @brief Default relative variation below which a component is frozen
+     */
+    static constexpr float DEFAULT_LOD_THRESHOLD = 0.25f;
+
+    /**
+     * @brief Construct sampler for a region of the wind field
+     *
+     * @param wind Wind generator to sample (non-owning, must outlive the sampler)
+     * @param min_corner Minimum corner of the region (x=crossrange, y=vertical, z=-downrange) in m
+     * @param max_corner Maximum corner of the region (x=crossrange, y=vertical, z=-downrange) in m
+     * @param time_horizon_s Time the frozen components are held before refresh() re-evaluates them in s
+     * @param lod_threshold Maximum relative variation (region span / scale, summed over axes) for freezing a component
+     */
+    WindLodSampler(const WindGenerator& wind, const btk::math::Vector3D& min_corner, const btk::math::Vector3D& max_corner, float time_horizon_s = 0.0f,
+                   float lod_threshold = DEFAULT_LOD_THRESHOLD);
+
+    /**
+     * @brief Sample wind at a specific location
+     *
+     * @param pos Position vector (x=crossrange, y=vertical, z=-downrange) in meters
+     * @return Wind vector (m/s) in BTK coordinates: (x=crosswind, y=vertical, z=-headwind)
+     */
+    btk::math::Vector3D sample(const btk::math::Vector3D& pos) const;
+
+    /**
+     * @brief Sample wind at a specific location
+     *
+     * @param x_m X coordinate in meters (crossrange)
+     * @param y_m Y coordinate in meters (vertical)
+     * @param z_m Z coordinate in meters (-downrange)
+     * @return Wind vector (m/s) in BTK coordinates: (x=crosswind, y=vertical, z=-headwind)
+     */
+    btk::math::Vector3D operator()(float x_m, float y_m, float z_m) const;
+
+    /**
+     * @brief Re-evaluate frozen components if the generator has advanced past the time horizon
+     *
+     * @return True if the frozen components were re-evaluated
+     */
+    bool refresh();
+
+    /**
+     * @brief Get the number of components held constant over the region
+     */
+    int getNumFrozenComponents() const { return num_frozen_; }
+
+    /**
+     * @brief Get the number of components sampled per call
+     */
+    int getNumLiveComponents() const { return static_cast<int>(live_components_.size()); }
+
+    private:
+    // Classify components and evaluate the frozen ones at the region center
+    void build();
+
+    // Sum of all frozen components at a position (build-time only)
+    btk::math::Vector3D sampleFrozen(const btk::math::Vector3D& pos) const;
+
+    const WindGenerator* wind_;
+    btk::math::Vector3D min_corner_;
+    btk::math::Vector3D max_corner_;
+    float time_horizon_s_;
+    float lod_threshold_;
+
+    float built_time_ = 0.0f;              // Generator time at which frozen components were evaluated
+    int num_frozen_ = 0;                   // Number of frozen components
+    std::vector<bool> frozen_;             // Per-component freeze flag
+    std::vector<int> live_components_;     // Indices of components sampled per call
+    btk::math::Vector3D center_;           // Region center
+    btk::math::Vector3D frozen_value_;     // Sum of frozen components at the region center
+    btk::math::Vector3D frozen_grad_x_;    // d(frozen)/dx (per meter crossrange)
+    btk::math::Vector3D frozen_grad_z_;    // d(frozen)/dz (per meter -downrange)
   };
 
   /**
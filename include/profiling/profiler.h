@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace btk::profiling
+{
+
+  /**
+   * @brief Hot-path counters and timers, compiled in with BTK_PROFILING.
+   *
+   * Engine code records through the BTK_PROFILE_SCOPE / BTK_PROFILE_COUNT
+   * macros, which expand to nothing unless BTK_PROFILING is defined (CMake
+   * option BTK_PROFILING), so regular builds carry no instrumentation. Totals
+   * accumulate in one process-wide profiler (atomics, so worker threads of
+   * ImpactDetector::findFirstImpactBatch may record too) until endFrame()
+   * moves them into the frame snapshot.
+   */
+  class Profiler
+  {
+    public:
+    /// Event counters
+    enum Counter : uint8_t
+    {
+      TRAJECTORY_STEPS = 0,  ///< Ballistic integration steps
+      WIND_SAMPLES = 1,      ///< WindGenerator / WindLodSampler samples
+      NOISE_EVALUATIONS = 2, ///< Simplex noise evaluations
+      BROADPHASE_CELLS = 3,  ///< ImpactDetector grid cells visited
+      TRIANGLE_TESTS = 4,    ///< Ray/triangle tests against mesh colliders
+      STEEL_SUBSTEPS = 5,    ///< Steel chain solver substeps (per target, or per SIMD block in SteelTargetWorld)
+      TEXTURE_PIXELS = 6,    ///< Steel texture texels written by impact marks
+      COUNTER_COUNT = 7
+    };
+
+    /// Scoped timers (inclusive; wind sampling inside a trajectory counts towards both)
+    enum Timer : uint8_t
+    {
+      TRAJECTORY = 0,       ///< Simulator::simulate
+      WIND = 1,             ///< Wind sampling
+      IMPACT_DETECTION = 2, ///< ImpactDetector::findFirstImpact / findFirstImpactBatch
+      STEEL_PHYSICS = 3,    ///< SteelTarget::timeStep / SteelTargetWorld::step
+      TEXTURE_PAINT = 4,    ///< Drawing impact marks into steel textures
+      TIMER_COUNT = 5
+    };
+
+    /**
+     * @brief Counts and times recorded during one frame
+     */
+    struct FrameSnapshot
+    {
+      uint32_t frame_;            ///< Frames ended so far, including this one
+      double trajectory_steps_;   ///< See Counter
+      double wind_samples_;
+      double noise_evaluations_;
+      double broadphase_cells_;
+      double triangle_tests_;
+      double steel_substeps_;
+      double texture_pixels_;
+      double trajectory_ms_;      ///< See Timer
+      double wind_ms_;
+      double impact_detection_ms_;
+      double steel_physics_ms_;
+      double texture_paint_ms_;
+
+      FrameSnapshot()
+        : frame_(0), trajectory_steps_(0.0), wind_samples_(0.0), noise_evaluations_(0.0), broadphase_cells_(0.0), triangle_tests_(0.0), steel_substeps_(0.0), texture_pixels_(0.0),
+          trajectory_ms_(0.0), wind_ms_(0.0), impact_detection_ms_(0.0), steel_physics_ms_(0.0), texture_paint_ms_(0.0)
+      {
+      }
+    };
+
+    /// Whether the engine was built with BTK_PROFILING (otherwise snapshots stay zero)
+    static constexpr bool isEnabled()
+    {
+#ifdef BTK_PROFILING
+      return true;
+#else
+      return false;
+#endif
+    }
+
+    /// Add to a counter (use BTK_PROFILE_COUNT in engine code)
+    static void count(Counter counter, uint64_t amount) { instance_.counters_[counter].fetch_add(amount, std::memory_order_relaxed); }
+
+    /// Add elapsed time to a timer (use BTK_PROFILE_SCOPE in engine code)
+    static void addTime(Timer timer, uint64_t ns) { instance_.timers_ns_[timer].fetch_add(ns, std::memory_order_relaxed); }
+
+    /**
+     * @brief Close the current frame: move its totals into the frame snapshot and start from zero
+     * @return The snapshot of the frame just ended
+     */
+    static FrameSnapshot endFrame();
+
+    /// Snapshot of the last frame closed by endFrame()
+    static FrameSnapshot getFrameSnapshot() { return instance_.last_frame_; }
+
+    /// Discard the current totals and the last snapshot
+    static void reset();
+
+    private:
+    std::atomic<uint64_t> counters_[COUNTER_COUNT] = {};
+    std::atomic<uint64_t> timers_ns_[TIMER_COUNT] = {};
+    FrameSnapshot last_frame_;
+    uint32_t frame_count_ = 0;
+
+    static Profiler instance_;
+  };
+
+  /**
+   * @brief Adds the lifetime of a scope to a Profiler timer
+   */
+  class ScopedTimer
+  {
+    public:
+    explicit ScopedTimer(Profiler::Timer timer) : timer_(timer), start_(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() { Profiler::addTime(timer_, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count())); }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+    Profiler::Timer timer_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+} // namespace btk::profiling
+
+#define BTK_PROFILE_CONCAT_INNER(a, b) a##b
+#define BTK_PROFILE_CONCAT(a, b) BTK_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef BTK_PROFILING
+/// Time the rest of the enclosing scope, e.g. BTK_PROFILE_SCOPE(TRAJECTORY)
+#define BTK_PROFILE_SCOPE(timer) ::btk::profiling::ScopedTimer BTK_PROFILE_CONCAT(btk_profile_scope_, __LINE__)(::btk::profiling::Profiler::timer)
+/// Add amount to a counter, e.g. BTK_PROFILE_COUNT(WIND_SAMPLES, 1)
+#define BTK_PROFILE_COUNT(counter, amount) ::btk::profiling::Profiler::count(::btk::profiling::Profiler::counter, static_cast<uint64_t>(amount))
+#else
+#define BTK_PROFILE_SCOPE(timer) static_cast<void>(0)
+// Unevaluated, so local tallies still count as used
+#define BTK_PROFILE_COUNT(counter, amount) static_cast<void>(sizeof(amount))
+#endif
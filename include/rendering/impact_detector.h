@@ -3,8 +3,9 @@
 #include "ballistics/trajectory.h"
 #include "math/quaternion.h"
 #include "math/vector.h"
+#include "rendering/mesh_bvh.h"
 #include "rendering/steel_target.h"
-#include <map>
+#include "rendering/triangle_blocks.h"
 #include <memory>
 #include <optional>
 #include <vector>
@@ -69,6 +70,25 @@ namespace btk::rendering
      */
     std::optional<ImpactResult> intersectSegment(const btk::math::Vector3D& start_m, const btk::math::Vector3D& end_m, float t_start_s, float t_end_s, float bullet_radius) const;
 
+    /**
+     * @brief Test a polyline of consecutive segments against this collider.
+     *
+     * Segments are tested in order and the first hit is returned; mesh colliders
+     * transform each point to local space at most once rather than once per segment.
+     *
+     * Moving colliders (see isMoving) are swept in time: each point is compared
+     * with the pose the collider has at that point's time, extrapolated from the
+     * current transform by the collider's linear and angular velocity.
+     *
+     * @param positions        Polyline points in BTK coordinates (meters), segment_count + 1 entries
+     * @param times            Time at each point (seconds), segment_count + 1 entries
+     * @param segment_count    Number of segments (positions[i] -> positions[i + 1])
+     * @param bullet_radius    Bullet radius for line-break rule (meters)
+     * @param reference_time_s Time at which the current transform applies (seconds)
+     * @return ImpactResult of the earliest hit, std::nullopt otherwise
+     */
+    std::optional<ImpactResult> intersectPolyline(const btk::math::Vector3D* positions, const float* times, size_t segment_count, float bullet_radius, float reference_time_s) const;
+
     /**
      * @brief Set world transform (position and rotation).
      *
@@ -77,6 +97,31 @@ namespace btk::rendering
      */
     void setTransform(const btk::math::Vector3D& position, const btk::math::Quaternion& rotation);
 
+    /**
+     * @brief Set rigid-body velocity for time-aware queries (mesh mode).
+     *
+     * Steel target colliders take their velocity from the SteelTarget instead.
+     *
+     * @param linear_velocity  Velocity of the collider position (m/s)
+     * @param angular_velocity Angular velocity about the collider position (rad/s, world axes)
+     */
+    void setVelocity(const btk::math::Vector3D& linear_velocity, const btk::math::Vector3D& angular_velocity);
+
+    /// Check if this collider moves during queries (steel targets report whether they have settled)
+    bool isMoving() const;
+
+    /// Check if this collider is a steel target
+    bool isSteelTarget() const { return steel_target_ != nullptr; }
+
+    /**
+     * @brief World bounds grown to cover every pose within max_dt_s of the current one.
+     *
+     * @param max_dt_s   Largest time offset from the current transform (seconds)
+     * @param min_bounds Out: swept AABB min (world space)
+     * @param max_bounds Out: swept AABB max (world space)
+     */
+    void sweptBounds(float max_dt_s, btk::math::Vector3D& min_bounds, btk::math::Vector3D& max_bounds) const;
+
     /// Grid management - get AABB min bounds (world space)
     const btk::math::Vector3D& minBounds() const;
 
@@ -96,9 +141,11 @@ namespace btk::rendering
     private:
     // Mesh data (only used when steel_target_ == nullptr)
     std::vector<btk::math::Vector3D> vertices_; ///< Vertices in local space
-    std::vector<uint32_t> indices_;
-    btk::math::Vector3D local_min_; ///< AABB min in local space
-    btk::math::Vector3D local_max_; ///< AABB max in local space
+    std::vector<uint32_t> indices_;             ///< Triangle indices in BVH leaf order
+    MeshBvh bvh_;                               ///< Triangle hierarchy in local space
+    TriangleBlocks triangle_blocks_;            ///< SoA copy of the triangles in the same order
+    btk::math::Vector3D local_min_;             ///< AABB min in local space
+    btk::math::Vector3D local_max_;             ///< AABB max in local space
 
     // Transform (applies to mesh mode)
     btk::math::Vector3D position_;   ///< World position
@@ -108,6 +155,10 @@ namespace btk::rendering
     btk::math::Vector3D min_bounds_m_; ///< AABB min bounds for grid binning
     btk::math::Vector3D max_bounds_m_; ///< AABB max bounds for grid binning
 
+    // Rigid-body motion (mesh mode; steel targets report their own)
+    btk::math::Vector3D linear_velocity_;  ///< Velocity of position_ (m/s)
+    btk::math::Vector3D angular_velocity_; ///< Angular velocity about position_ (rad/s)
+
     // Steel target mode (if not null, this is a steel target)
     // For steel targets, min_bounds_m_.x stores the radius (local bounds not used)
     btk::rendering::SteelTarget* steel_target_ = nullptr;
@@ -121,8 +172,15 @@ namespace btk::rendering
 
     bool segmentIntersectsAABB(const btk::math::Vector3D& start_m, const btk::math::Vector3D& end_m, const btk::math::Vector3D& min_bounds, const btk::math::Vector3D& max_bounds) const;
 
-    std::optional<float> intersectTriangle(const btk::math::Vector3D& ray_origin, const btk::math::Vector3D& ray_dir, const btk::math::Vector3D& v0, const btk::math::Vector3D& v1,
-                                           const btk::math::Vector3D& v2) const;
+    // Pivot and velocities of the rigid motion (mesh: position_, steel: target centre of mass)
+    void getMotion(btk::math::Vector3D& pivot, btk::math::Vector3D& linear_velocity, btk::math::Vector3D& angular_velocity) const;
+
+    // Segment test against the collider's pose over time (points given at reference + dt)
+    std::optional<ImpactResult> intersectMovingSegment(const btk::math::Vector3D& start_m, const btk::math::Vector3D& end_m, float t_start_s, float t_end_s, float bullet_radius,
+                                                       float reference_time_s) const;
+
+    // Closest triangle hit of a local-space segment (t in [0, 1] along local_dir)
+    bool intersectMeshLocal(const btk::math::Vector3D& local_start, const btk::math::Vector3D& local_dir, float& hit_t, btk::math::Vector3D& hit_normal_local) const;
   };
 
   /**
@@ -130,6 +188,12 @@ namespace btk::rendering
    *
    * Grid bins are defined over the XZ plane (BTK coords). Each object is
    * registered with its AABB and inserted into all overlapping bins.
+   * Colliders live in a contiguous array addressed through generational
+   * handles, and bins are stored as one compact index array (CSR). Moving
+   * colliders (steel targets, meshes with a velocity) stay out of the bins and
+   * are swept through each query's time window instead.
+   * Queries walk only the bins a segment crosses (2D DDA) and collect each
+   * collider once per run of segments before any narrowphase test.
    */
   class ImpactDetector
   {
@@ -160,9 +224,23 @@ namespace btk::rendering
     int addMeshCollider(emscripten::val vertices_val, emscripten::val indices_val, int object_id);
 #endif
 
+    /**
+     * @brief Register a static mesh collider from world-space geometry.
+     *
+     * @param vertices  Flat array [x0,y0,z0, ...] in meters (world space)
+     * @param indices   Triangle indices (empty for sequential)
+     * @param object_id Application ID
+     * @return Collider handle (>=0) or -1 on error
+     */
+    int addMeshCollider(const std::vector<float>& vertices, const std::vector<uint32_t>& indices, int object_id);
+
     /**
      * @brief Register a moving steel target.
      *
+     * Swinging targets are swept like moving mesh colliders; settled ones are
+     * binned in the grid. Each query checks whether a target woke or settled
+     * since the grid was built and re-sorts it.
+     *
      * @param target      SteelTarget pointer (non-owning, must outlive detector)
      * @param radius_m    Radius for bin coverage (accounts for swing)
      * @param object_id   Application ID
@@ -174,9 +252,25 @@ namespace btk::rendering
 
     void removeCollider(int handle);
 
+    /**
+     * @brief Set the rigid-body velocity of a mesh collider.
+     *
+     * Moving colliders are tested against the pose they have at each trajectory
+     * time, extrapolated from their current transform, instead of a frozen pose.
+     * Steel target colliders always use their SteelTarget's velocity.
+     *
+     * @param handle           Collider handle
+     * @param linear_velocity  Velocity of the collider position (m/s)
+     * @param angular_velocity Angular velocity about the collider position (rad/s, world axes)
+     */
+    void setColliderVelocity(int handle, const btk::math::Vector3D& linear_velocity, const btk::math::Vector3D& angular_velocity);
+
     /**
      * @brief Find first impact of a trajectory in time interval [t0, t1].
      *
+     * Collider transforms are taken to be current at t0 (colliders are updated
+     * once per frame, before the bullet advances through the frame).
+     *
      * @param trajectory Bullet trajectory in BTK coords
      * @param t0_s       Start time (seconds)
      * @param t1_s       End time (seconds)
@@ -184,6 +278,35 @@ namespace btk::rendering
      */
     std::optional<ImpactResult> findFirstImpact(const btk::ballistics::Trajectory& trajectory, float t0_s, float t1_s) const;
 
+    /**
+     * @brief Find first impact with collider transforms current at a given trajectory time.
+     *
+     * @param trajectory       Bullet trajectory in BTK coords
+     * @param t0_s             Start time (seconds)
+     * @param t1_s             End time (seconds)
+     * @param reference_time_s Trajectory time at which collider transforms apply (seconds)
+     * @return ImpactResult if hit, std::nullopt otherwise
+     */
+    std::optional<ImpactResult> findFirstImpact(const btk::ballistics::Trajectory& trajectory, float t0_s, float t1_s, float reference_time_s) const;
+
+    /**
+     * @brief Find the first impact of each of many trajectories in [t0, t1].
+     *
+     * Meant for volleys and Monte Carlo hit probability: all trajectories are
+     * tested against the same scene in one pass. Segment runs of every
+     * trajectory are sorted by grid bin, so each bin and its colliders are
+     * visited once for all trajectories rather than once per trajectory.
+     * Natively the work can be split across threads; WebAssembly builds
+     * without pthreads always run on the calling thread.
+     *
+     * @param trajectories Bullet trajectories in BTK coords
+     * @param t0_s         Start time (seconds), also the time collider transforms apply
+     * @param t1_s         End time (seconds)
+     * @param thread_count Worker threads (<= 0 uses the hardware concurrency)
+     * @return One result per trajectory; object_id is -1 where nothing was hit
+     */
+    std::vector<ImpactResult> findFirstImpactBatch(const std::vector<btk::ballistics::Trajectory>& trajectories, float t0_s, float t1_s, int thread_count = 1) const;
+
     /**
      * @brief Enable or disable a collider by handle.
      *
@@ -202,7 +325,8 @@ namespace btk::rendering
      */
     bool isColliderEnabled(int handle) const;
 
-    int getNextHandle() { return next_handle_++; }
+    /// Get number of registered colliders
+    size_t getColliderCount() const { return colliders_.size(); }
 
     private:
     float bin_size_m_;
@@ -213,16 +337,118 @@ namespace btk::rendering
     int bins_x_;
     int bins_z_;
 
-    int next_handle_ = 0;
-
-    std::vector<std::vector<Collider*>> grid_; ///< bins_x_ * bins_z_ bins, stores pointers to colliders
-    std::map<int, Collider> colliders_;        ///< Handle -> Collider map (std::map for pointer stability)
+    /// Collider collected by the broadphase with the run of segments that reached it
+    struct PolylineCandidate
+    {
+      const Collider* collider;
+      size_t first_segment;
+      size_t last_segment;
+    };
+
+    /// Broadphase scratch of one query; batch queries use one per worker thread
+    struct QueryScratch
+    {
+      std::vector<PolylineCandidate> candidates; ///< Colliders collected for the current chunk
+      std::vector<uint32_t> stamps;              ///< Mailbox: last stamp that collected each dense collider
+      std::vector<uint32_t> slots;               ///< Candidate index of each collider under that stamp
+      uint32_t stamp = 0;                        ///< Stamp of the current chunk
+    };
+
+    /// Consecutive segments of one batch trajectory inside one grid bin
+    struct CellRun
+    {
+      uint32_t cell;          ///< Grid index
+      uint32_t trajectory;    ///< Index into the batch
+      uint32_t first_segment; ///< First segment (trajectory point index)
+      uint32_t last_segment;  ///< Last segment (inclusive)
+    };
+
+    mutable QueryScratch scratch_; ///< Scratch of findFirstImpact (reused across queries)
+
+    /// Segments packed and traversed per chunk in findFirstImpact
+    static constexpr int POLYLINE_CHUNK_SEGMENTS = 16;
+
+    /// Rounds of findFirstImpactBatch start at one chunk per trajectory and double up to this many segments
+    static constexpr int BATCH_MAX_ROUND_SEGMENTS = 1024;
+
+    /// Handle table entry: handles are (generation << HANDLE_SLOT_BITS) | slot
+    struct ColliderSlot
+    {
+      uint32_t dense_index = 0; ///< Index into colliders_ while alive
+      uint32_t generation = 0;  ///< Bumped on removal so stale handles are rejected
+      bool alive = false;
+    };
+
+    /// Inclusive range of grid bins covered by a collider's bounds
+    struct BinRect
+    {
+      int min_x;
+      int max_x;
+      int min_z;
+      int max_z;
+
+      bool operator==(const BinRect& other) const { return min_x == other.min_x && max_x == other.max_x && min_z == other.min_z && max_z == other.max_z; }
+    };
+
+    /// Steel collider and whether it was moving at the last grid rebuild
+    struct SteelEntry
+    {
+      uint32_t index; ///< Dense collider index
+      bool moving;
+    };
+
+    static constexpr int HANDLE_SLOT_BITS = 20;
+    static constexpr uint32_t HANDLE_SLOT_MASK = (1u << HANDLE_SLOT_BITS) - 1;
+    static constexpr uint32_t HANDLE_GENERATION_MASK = (1u << (31 - HANDLE_SLOT_BITS)) - 1; ///< Keeps handles non-negative
+
+    // Colliders are stored contiguously and swap-removed; handles go through the slot table
+    std::vector<Collider> colliders_;      ///< Dense collider storage
+    std::vector<uint32_t> collider_slots_; ///< Slot of each dense collider
+    std::vector<BinRect> collider_bins_;   ///< Bins covered by each dense collider
+    std::vector<ColliderSlot> slots_;      ///< Handle slot table
+    std::vector<uint32_t> free_slots_;     ///< Slots available for reuse
+
+    // Grid in compressed sparse row form, rebuilt before the next query whenever bins change
+    mutable std::vector<uint32_t> cell_offsets_; ///< bins_x_ * bins_z_ + 1 offsets into cell_entries_
+    mutable std::vector<uint32_t> cell_entries_; ///< Dense collider indices grouped by bin
+    mutable std::vector<uint32_t> moving_;       ///< Dense indices of moving colliders (kept out of the bins)
+    mutable std::vector<SteelEntry> steel_;      ///< Steel colliders with the motion state they were sorted by
+    mutable std::vector<uint32_t> occupied_sat_; ///< (bins_x_ + 1) * (bins_z_ + 1) summed-area table of non-empty bins
+    mutable bool grid_dirty_ = false;
 
     int binIndexX(float x_m) const;
     int binIndexZ(float z_m) const;
-    int gridIndex(int bin_x, int bin_z) const;
+    BinRect binRectOf(const Collider& collider) const;
+
+    // Dense index of a live handle, or -1
+    int denseIndexOf(int handle) const;
+
+    // Store a collider, assign a handle and mark the grid dirty
+    int insertCollider(Collider&& collider, int object_id);
+
+    // Rebuild cell_offsets_/cell_entries_/moving_/steel_ from collider_bins_ (counting sort, reuses capacity)
+    void rebuildGrid() const;
+
+    // Check whether a steel target woke or settled since the last rebuild, so it must move
+    // between the bins and moving_
+    bool steelMotionChanged() const;
+
+    // Check whether any bin under an XZ box (clamped to the grid) holds a static collider, in O(1)
+    bool anyBinned(const btk::math::Vector3D& min_m, const btk::math::Vector3D& max_m) const;
+
+    // Visit grid indices of the bins crossed by a segment inflated by radius_m (Amanatides-Woo DDA in XZ)
+    template <typename Visitor>
+    void traverseSegment(const btk::math::Vector3D& start_m, const btk::math::Vector3D& end_m, float radius_m, Visitor&& visit) const;
+
+    // Index of the last trajectory point at or before t0_s (start of the first segment that may overlap the window)
+    static int windowStart(const btk::ballistics::Trajectory& trajectory, float t0_s);
+
+    // Earliest hit of a polyline (segment_count <= POLYLINE_CHUNK_SEGMENTS) against the grid
+    std::optional<ImpactResult> checkPolylineCollisions(QueryScratch& scratch, const btk::math::Vector3D* positions, const float* times, size_t segment_count, float bullet_radius,
+                                                        float reference_time_s) const;
 
-    std::optional<ImpactResult> checkSegmentCollisions(const btk::math::Vector3D& start_m, const btk::math::Vector3D& end_m, float t_start_s, float t_end_s, float bullet_radius) const;
+    // Earliest hit of a polyline against the moving colliders only (chunk culled by swept bounds)
+    std::optional<ImpactResult> checkMovingCollisions(const btk::math::Vector3D* positions, const float* times, size_t segment_count, float bullet_radius, float reference_time_s) const;
   };
 
 } // namespace btk::rendering
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "math/vector.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace btk::rendering
+{
+
+  /**
+   * @brief Bounding volume hierarchy over a triangle mesh.
+   *
+   * Built once with the binned surface area heuristic (SAH) and stored as a
+   * flat depth-first node array: an interior node's left child immediately
+   * follows it, and leaves reference contiguous triangle ranges. Building
+   * reorders the mesh triangles to match, so leaf triangles are adjacent in
+   * memory and traversal cost per segment is O(log n) instead of O(n).
+   */
+  class MeshBvh
+  {
+    public:
+    /**
+     * @brief Flattened BVH node (32 bytes).
+     */
+    struct Node
+    {
+      btk::math::Vector3D min_bounds; ///< AABB min (local space)
+      uint32_t offset;                ///< Leaf: first triangle; interior: right child node index
+      btk::math::Vector3D max_bounds; ///< AABB max (local space)
+      uint16_t count;                 ///< Triangle count (0 for interior nodes)
+      uint16_t axis;                  ///< Split axis of interior nodes (0 = x, 1 = y, 2 = z)
+    };
+
+    /**
+     * @brief Build the hierarchy.
+     *
+     * @param vertices Mesh vertices (local space)
+     * @param indices  Triangle indices, reordered in place so each leaf covers consecutive triangles
+     */
+    void build(const std::vector<btk::math::Vector3D>& vertices, std::vector<uint32_t>& indices);
+
+    /**
+     * @brief Visit leaves hit by the segment origin + t * dir, t in [0, t_max], nearest child first.
+     *
+     * The leaf test receives (first_triangle, triangle_count, t_max) and returns true
+     * when it found a closer hit, lowering t_max so farther nodes are culled.
+     *
+     * @param origin    Segment start (local space)
+     * @param dir       Segment direction (local space, t = 1 at segment end)
+     * @param t_max     In: farthest t to consider; out: t of the closest hit
+     * @param test_leaf Leaf callback bool(uint32_t first, uint32_t count, float& t_max)
+     * @return True if any leaf test reported a hit
+     */
+    template <typename LeafTest>
+    bool intersect(const btk::math::Vector3D& origin, const btk::math::Vector3D& dir, float& t_max, LeafTest&& test_leaf) const;
+
+    /// Get flattened nodes (root at index 0)
+    const std::vector<Node>& getNodes() const { return nodes_; }
+
+    /// Check whether the hierarchy has been built over a non-empty mesh
+    bool empty() const { return nodes_.empty(); }
+
+    private:
+    /// Worst-case depth: SAH levels are capped, then median splits halve the range
+    static constexpr int MAX_DEPTH = 64;
+    static constexpr int MAX_SAH_DEPTH = 32;
+    static constexpr int SAH_BINS = 12;
+    static constexpr uint32_t MAX_LEAF_TRIANGLES = 4;      ///< Leaves at or below this size are never split
+    static constexpr uint32_t MAX_SAH_LEAF_TRIANGLES = 16; ///< Larger ranges are split even when SAH prefers a leaf
+    static constexpr float TRAVERSAL_COST = 1.0f;          ///< SAH node cost relative to one triangle test
+
+    struct BuildTriangle
+    {
+      btk::math::Vector3D min_bounds;
+      btk::math::Vector3D max_bounds;
+      btk::math::Vector3D centroid;
+      uint32_t index; ///< Original triangle number
+    };
+
+    std::vector<Node> nodes_;
+
+    uint32_t buildNode(std::vector<BuildTriangle>& triangles, uint32_t first, uint32_t count, int depth);
+  };
+
+  template <typename LeafTest>
+  bool MeshBvh::intersect(const btk::math::Vector3D& origin, const btk::math::Vector3D& dir, float& t_max, LeafTest&& test_leaf) const
+  {
+    if(nodes_.empty())
+    {
+      return false;
+    }
+
+    // Same slab conventions as Collider::segmentIntersectsAABB
+    constexpr float BIG = std::numeric_limits<float>::max();
+    const float inv_x = dir.x > 1e-6f || dir.x < -1e-6f ? 1.0f / dir.x : BIG;
+    const float inv_y = dir.y > 1e-6f || dir.y < -1e-6f ? 1.0f / dir.y : BIG;
+    const float inv_z = dir.z > 1e-6f || dir.z < -1e-6f ? 1.0f / dir.z : BIG;
+    const bool negative[3] = {dir.x < 0.0f, dir.y < 0.0f, dir.z < 0.0f};
+
+    auto overlaps = [&](const Node& node)
+    {
+      float tx1 = (node.min_bounds.x - origin.x) * inv_x;
+      float tx2 = (node.max_bounds.x - origin.x) * inv_x;
+      float ty1 = (node.min_bounds.y - origin.y) * inv_y;
+      float ty2 = (node.max_bounds.y - origin.y) * inv_y;
+      float tz1 = (node.min_bounds.z - origin.z) * inv_z;
+      float tz2 = (node.max_bounds.z - origin.z) * inv_z;
+      float t_enter = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::max(std::min(tz1, tz2), 0.0f));
+      float t_exit = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::min(std::max(tz1, tz2), t_max));
+      return t_enter <= t_exit;
+    };
+
+    uint32_t stack[MAX_DEPTH];
+    int stack_size = 0;
+    uint32_t node_index = 0;
+    bool hit = false;
+
+    while(true)
+    {
+      const Node& node = nodes_[node_index];
+      if(overlaps(node))
+      {
+        if(node.count > 0)
+        {
+          hit |= test_leaf(node.offset, static_cast<uint32_t>(node.count), t_max);
+        }
+        else
+        {
+          // Descend into the near child; the far child waits on the stack
+          if(negative[node.axis])
+          {
+            stack[stack_size++] = node_index + 1;
+            node_index = node.offset;
+          }
+          else
+          {
+            stack[stack_size++] = node.offset;
+            node_index = node_index + 1;
+          }
+          continue;
+        }
+      }
+
+      if(stack_size == 0)
+      {
+        break;
+      }
+      node_index = stack[--stack_size];
+    }
+
+    return hit;
+  }
+
+} // namespace btk::rendering
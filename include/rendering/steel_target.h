@@ -4,7 +4,9 @@
 #include "ballistics/trajectory.h"
 #include "math/quaternion.h"
 #include "math/vector.h"
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <optional>
 #include <vector>
 
@@ -62,6 +64,15 @@ namespace btk::rendering
       }
     };
 
+    /**
+     * @brief How chain anchors are integrated
+     */
+    enum ChainSolver : uint8_t
+    {
+      SPRING = 0,  // Stiff springs with semi-implicit Euler (1 ms substeps)
+      IMPLICIT = 1 // Same springs integrated implicitly, stable at frame-rate steps (adaptive substeps)
+    };
+
     /**
      * @brief Result of a simple ray-style intersection test against the target
      */
@@ -74,6 +85,30 @@ namespace btk::rendering
       RaycastHit() : point_world_(0, 0, 0), normal_world_(0, 0, 0), distance_m_(0.0f) {}
     };
 
+    /**
+     * @brief Floats per impact decal in getDecals()
+     *
+     * Each decal is [u, v, radius_u, radius_v, face, seed, spike_count, 0]:
+     * centre and splatter radii in face UV units (0-1 across one face), face
+     * 0 = front / 1 = back, a 24-bit seed for decalRandom(), and the number of
+     * spikes. Everything else about the mark is derived from the seed, so a
+     * shader can redraw it exactly like the CPU rasteriser.
+     */
+    static constexpr int DECAL_STRIDE = 8;
+
+    /**
+     * @brief Texture region in pixels changed since the last clearDirtyRect()
+     */
+    struct DirtyRect
+    {
+      int x_;      ///< Left column
+      int y_;      ///< Top row
+      int width_;  ///< Width in pixels (0 when nothing changed)
+      int height_; ///< Height in pixels (0 when nothing changed)
+
+      DirtyRect() : x_(0), y_(0), width_(0), height_(0) {}
+    };
+
     /**
      * @brief Initialize steel target with single shape at origin
      *
@@ -117,29 +152,34 @@ namespace btk::rendering
     void hit(const btk::ballistics::Bullet& bullet);
 
     /**
-     * @brief Ray-style intersection test with the target using a line segment.
+     * @brief Swept-sphere intersection test with the target using a line segment.
      *
      * The segment is defined in world coordinates by two endpoints. The method
-     * transforms the segment into the target's local space and tests against
-     * the finite plate (rectangle or oval) lying in the target's mid-plane.
-     *
-     * Uses the "line break rule": if bullet_radius > 0, expands the target
-     * bounds by the bullet radius, so near-misses within the bullet radius count as hits.
+     * transforms the segment into the target's local space and tests a sphere of
+     * bullet_radius moving along it against the finite plate (rectangle or oval)
+     * lying in the target's mid-plane, in closed form:
+     * - face contact: the centre comes within bullet_radius of the mid-plane
+     *   while projecting inside the plate outline;
+     * - rim contact ("line break rule"): the centre crosses the mid-plane within
+     *   bullet_radius of the outline (exact rounded rectangle; for ovals both
+     *   semi-axes grow by the radius).
      *
      * @param start World-space start point of the segment
      * @param end World-space end point of the segment
      * @param bullet_radius Bullet radius in meters (default 0, no expansion)
-     * @return RaycastHit with world-space impact point/normal if hit, std::nullopt otherwise
+     * @return RaycastHit with the world-space contact point on the plate, the plate normal, and the
+     *         distance the bullet centre travelled along the segment; std::nullopt if the segment misses
      */
     std::optional<RaycastHit> intersectSegment(const btk::math::Vector3D& start, const btk::math::Vector3D& end, float bullet_radius = 0.0f) const;
 
     /**
      * @brief Intersect a full bullet trajectory with this target.
      *
-     * Uses the target's current pose to compute its downrange extent, then
-     * extracts the corresponding segment from the trajectory and raycasts it
-     * against the plate. If an impact is found, returns the corresponding
-     * TrajectoryPoint (state along the trajectory) at the impact distance.
+     * Uses the target's current pose to compute its downrange extent in closed
+     * form (padded by the bullet radius), then extracts the corresponding segment
+     * from the trajectory and tests it against the plate with intersectSegment.
+     * If an impact is found, returns the corresponding TrajectoryPoint (state
+     * along the trajectory) at the impact distance.
      *
      * @param trajectory Bullet trajectory in world coordinates
      * @return TrajectoryPoint at impact if hit, std::nullopt if the trajectory misses
@@ -149,10 +189,33 @@ namespace btk::rendering
     /**
      * @brief Advance physics simulation
      *
+     * With the SPRING solver dt is subdivided into 1 ms substeps; with IMPLICIT
+     * into as few substeps as keep rotation and chain oscillation per substep
+     * small (see implicitSubstepCount).
+     *
      * @param dt Time step in seconds
      */
     void timeStep(float dt);
 
+    /**
+     * @brief Select how chain anchors are integrated (default SPRING)
+     *
+     * IMPLICIT integrates the same chain springs and damping with backward
+     * Euler, so it converges to SPRING as substeps shrink. Its substeps only
+     * bound rotation and chain oscillation per step, so at 60 Hz it costs
+     * 3-11x less than SPRING (more for larger, slower plates). Plates from
+     * 0.3 m, hit off-centre and stepped at 8-33 ms, stay within 3.8 degrees of
+     * the converged motion over 3 s (SPRING: 2.4 degrees). 0.15 m plates
+     * tumble chaotically under either solver, so no step size reproduces one
+     * exact path.
+     */
+    void setChainSolver(ChainSolver solver) { chain_solver_ = solver; }
+
+    /**
+     * @brief Get the chain solver
+     */
+    ChainSolver getChainSolver() const { return chain_solver_; }
+
     /**
      * @brief Get all recorded impacts
      */
@@ -222,7 +285,8 @@ namespace btk::rendering
      *
      * Returns RGBA texture data as [r,g,b,a, r,g,b,a, ...] ready for WebGL texture.
      * Texture shows paint color with bullet impacts revealing metal underneath.
-     * Buffer is updated by calling updateTexture().
+     * Buffer is updated by calling updateTexture(). Empty while the target
+     * draws into a SteelTextureAtlas (use the atlas page instead).
      *
      * @return Memory view of texture buffer (RGBA bytes)
      */
@@ -238,15 +302,152 @@ namespace btk::rendering
     int getTextureWidth() const { return texture_width_; }
     int getTextureHeight() const { return texture_height_; }
 
+    /**
+     * @brief Change the texture resolution
+     *
+     * Reallocates the buffer (and mip chain) and redraws every decal at the
+     * new size; decals are resolution independent.
+     *
+     * @param texture_size Texture height in pixels (width is twice this)
+     * @throws std::invalid_argument if texture_size is not positive or the texture lives in a SteelTextureAtlas
+     */
+    void setTextureSize(int texture_size);
+
+    /**
+     * @brief Texture height that matches a plate's expected screen coverage
+     *
+     * Projects the plate's larger dimension at distance_m onto a viewport of
+     * viewport_height_px pixels with vertical field of view fov_y_rad and
+     * rounds texels_per_pixel times that up to a power of two in
+     * [16, max_size]. A 6-inch plate at 1,760 yards gets 16 texels where a
+     * 6-ft gong at 100 yards gets hundreds.
+     *
+     * @param plate_size_m Larger of the plate's width and height in meters
+     * @param distance_m Expected viewing distance in meters
+     * @param fov_y_rad Vertical field of view in radians (at the highest zoom the view is used with)
+     * @param viewport_height_px Viewport height in pixels
+     * @param texels_per_pixel Texels per covered screen pixel (default 1)
+     * @param max_size Largest texture height returned (default 1024)
+     */
+    static int textureSizeFor(float plate_size_m, float distance_m, float fov_y_rad, int viewport_height_px, float texels_per_pixel = 1.0f, int max_size = 1024);
+
+    /**
+     * @brief Enable or disable CPU-generated mip levels
+     *
+     * Levels 1.. are 2x2 box-filtered from the level above. They are rebuilt
+     * when the texture is (re)initialised and updated only around each new
+     * impact mark afterwards; the dirty rectangle scaled by 2^-level covers
+     * every changed texel of a level. Front and back halves never mix while
+     * the texture size is a power of two.
+     */
+    void setMipmapsEnabled(bool enabled);
+    bool isMipmapsEnabled() const { return mipmaps_enabled_; }
+
+    /**
+     * @brief Number of mip levels including the base texture (1 when mipmaps are disabled)
+     */
+    int getMipLevelCount() const { return 1 + static_cast<int>(mip_offsets_.size()); }
+
+    /**
+     * @brief Mip level dimensions (level 0 is the base texture)
+     */
+    int getMipLevelWidth(int level) const { return std::max(1, texture_width_ >> level); }
+    int getMipLevelHeight(int level) const { return std::max(1, texture_height_ >> level); }
+
+    /**
+     * @brief Get a mip level (1 .. getMipLevelCount() - 1) as a memory view for zero-copy access
+     *
+     * Tightly packed RGBA rows of getMipLevelWidth(level) pixels.
+     *
+     * @throws std::invalid_argument if level is out of range
+     */
+#ifdef __EMSCRIPTEN__
+    emscripten::val getMipLevel(int level) const;
+#else
+    const uint8_t* getMipLevel(int level) const;
+#endif
+
+    /**
+     * @brief Whether any texels changed since the last clearDirtyRect()
+     */
+    bool hasDirtyRect() const { return dirty_max_x_ > dirty_min_x_; }
+
+    /**
+     * @brief Bounding rectangle of all texels changed since the last clearDirtyRect()
+     *
+     * Impact marks only grow this rectangle; initializeTexture() (and so
+     * clearImpacts()/construction) marks the whole texture dirty.
+     */
+    DirtyRect getDirtyRect() const;
+
+    /**
+     * @brief Get the texture rows covered by the dirty rectangle as a memory view
+     *
+     * Returns full-width RGBA rows getDirtyRect().y_ .. y_ + height_ - 1, which
+     * start at byte offset y_ * getTextureWidth() * 4 in getTexture(). Rows are
+     * the smallest contiguous sub-range; use DirtyRect::x_/width_ with
+     * UNPACK_SKIP_PIXELS / UNPACK_ROW_LENGTH to upload only the rectangle.
+     * Empty when nothing is dirty or the texture lives in a SteelTextureAtlas
+     * (offset getDirtyRect() by the atlas region instead).
+     *
+     * @return Memory view of the dirty rows (RGBA bytes)
+     */
+#ifdef __EMSCRIPTEN__
+    emscripten::val getDirtyTextureRows() const;
+#endif
+
+    /**
+     * @brief Mark the texture as uploaded (empties the dirty rectangle)
+     */
+    void clearDirtyRect();
+
     /**
      * @brief Initialize texture with paint color
      *
      * Creates the initial texture filled with paint color.
      * Call this once during setup or when resetting the target.
+     * Does nothing while the texture is disabled.
      *
      */
     void initializeTexture();
 
+    /**
+     * @brief Enable or disable the CPU texture
+     *
+     * With the texture disabled the RGBA buffer is released and hits only
+     * append to the decal list (for renderers that draw getDecals()
+     * procedurally). Re-enabling repaints the texture and replays all decals.
+     */
+    void setTextureEnabled(bool enabled);
+    bool isTextureEnabled() const { return texture_enabled_; }
+
+    /**
+     * @brief Get the impact decal list as a memory view for zero-copy access
+     *
+     * DECAL_STRIDE floats per decal, oldest first; cleared by clearImpacts().
+     *
+     * @return Memory view of the decal floats
+     */
+#ifdef __EMSCRIPTEN__
+    emscripten::val getDecals() const;
+#else
+    const std::vector<float>& getDecals() const { return decals_; }
+#endif
+
+    /**
+     * @brief Number of impact decals
+     */
+    int getDecalCount() const { return static_cast<int>(decals_.size() / DECAL_STRIDE); }
+
+    /**
+     * @brief Deterministic random number in [0, 1) for a decal
+     *
+     * Index 0 picks the spike count; spike k uses indices 3k+1 (angle
+     * jitter), 3k+2 (length) and 3k+3 (width). lowbias32 integer hash of
+     * seed * 0x9E3779B9 + index, top 24 bits, so shaders can reproduce it.
+     */
+    static float decalRandom(uint32_t seed, uint32_t index);
+
     /**
      * @brief Set paint and metal colors
      *
@@ -270,6 +471,7 @@ namespace btk::rendering
     void clearImpacts()
     {
       impacts_.clear();
+      decals_.clear();
       initializeTexture();
     }
 
@@ -283,6 +485,9 @@ namespace btk::rendering
     void setDebug(bool debug) { debug_ = debug; }
 
     private:
+    friend class SteelTargetWorld; // Batch stepping reads and writes the physics state directly
+    friend class SteelTextureAtlas; // Binds atlas regions as texture storage
+
     // Steel density constant (kg/m³)
     static constexpr float STEEL_DENSITY = 7850.0f;
 
@@ -307,6 +512,14 @@ namespace btk::rendering
     // Time window for settle detection (must be below thresholds for this long)
     static constexpr float SETTLE_TIME_THRESHOLD_S = 1.0f; // seconds
 
+    // Maximum physics substep for the stiff chain springs
+    static constexpr float MAX_SUBSTEP_DT = 0.001f; // 1ms
+
+    // Substep bounds for IMPLICIT chains (stability does not depend on them, only swing accuracy)
+    static constexpr float IMPLICIT_MAX_SUBSTEP_DT = 0.02f;  // s; keeps jittery 60 Hz frames of a slow plate at one substep
+    static constexpr float IMPLICIT_MAX_ROTATION = 0.05f;    // rad of plate rotation per substep
+    static constexpr float IMPLICIT_MAX_CHAIN_PHASE = 0.25f; // rad of chain oscillation (sqrt(k / m) * dt) per substep
+
     // Maximum acceleration to prevent numerical instability
     static constexpr float MAX_ACCELERATION = 50.0f; // m/s²
 
@@ -325,6 +538,7 @@ namespace btk::rendering
     bool is_moving_;                       // True if target is moving (updated during timeStep)
     float time_below_threshold_s_ = 0.0f;  // Time spent below velocity thresholds
     bool debug_ = false;                   // Verbose debug logging flag
+    ChainSolver chain_solver_ = SPRING;    // Chain integration scheme
 
     // Physical properties
     float mass_kg_;
@@ -333,15 +547,28 @@ namespace btk::rendering
     // Constraints and impacts
     std::vector<ChainAnchor> anchors_;
     std::vector<Impact> impacts_;
+    std::vector<float> decals_; // DECAL_STRIDE floats per impact mark
 
     // Display buffer
 
     // Texture buffer (RGBA format) - single texture with front on left half, back on right half
-    std::vector<uint8_t> texture_buffer_; // Combined texture: r,g,b,a,r,g,b,a,...
+    std::vector<uint8_t> texture_buffer_; // Combined texture: r,g,b,a,r,g,b,a,... (empty while in an atlas)
+    uint8_t* shared_texture_data_ = nullptr; // Region origin in a SteelTextureAtlas page, or null
+    size_t texture_row_bytes_ = 0;        // Bytes between texture rows
     int texture_width_;                   // Total texture width in pixels (2x target aspect)
     int texture_height_;                  // Texture height in pixels
     uint8_t paint_color_[3];              // RGB paint color
     uint8_t metal_color_[3];              // RGB metal color
+    bool texture_enabled_ = true;         // False when marks are drawn from decals_ only
+    bool mipmaps_enabled_ = false;        // Maintain mip_buffer_ alongside the texture
+    std::vector<uint8_t> mip_buffer_;     // Mip levels 1.. packed back to back
+    std::vector<size_t> mip_offsets_;     // Byte offset of level 1 + i in mip_buffer_
+
+    // Texels changed since the last clearDirtyRect() as [min, max) bounds; empty when max <= min
+    int dirty_min_x_ = 0;
+    int dirty_min_y_ = 0;
+    int dirty_max_x_ = 0;
+    int dirty_max_y_ = 0;
 
     /**
      * @brief Calculate mass and moment of inertia from shape
@@ -353,6 +580,19 @@ namespace btk::rendering
      */
     void applyChainForces(float dt);
 
+    /**
+     * @brief Number of IMPLICIT substeps for a step of dt
+     *
+     * Shared with SteelTargetWorld, which passes the fastest spin and lightest
+     * mass of a block.
+     */
+    static int implicitSubstepCount(float dt, float angular_speed, float mass_kg);
+
+    /**
+     * @brief One IMPLICIT substep: implicit chain impulses, then semi-implicit Euler for the pose
+     */
+    void implicitSubstep(float dt);
+
     /**
      * @brief Apply instantaneous impulse at a world-space point
      */
@@ -367,20 +607,67 @@ namespace btk::rendering
      * @brief Record an impact for visualization and update texture
      *
      * Converts bullet data to local coordinates, stores the impact,
-     * and incrementally updates the texture with the new splatter mark.
+     * appends its decal and, with the texture enabled, draws the new splatter mark.
      */
     void recordImpact(const btk::ballistics::Bullet& bullet);
 
     /**
-     * @brief Draw a single impact splatter on the texture
-     *
-     * Draws the splatter mark for one impact with random spikes radiating outward.
+     * @brief Append the decal for one impact
      *
      * @param local_position Impact position in local coordinates
      * @param bullet_diameter Bullet diameter in meters
-     * @param is_front_face True to draw on front texture, false for back texture
+     * @param is_front_face True for the front face, false for the back face
+     * @return False if the position is outside the plate's texture
+     */
+    bool addDecal(const btk::math::Vector3D& local_position, float bullet_diameter, bool is_front_face);
+
+    /**
+     * @brief Draw a single impact decal on the texture (reference rasteriser)
+     *
+     * Draws the splatter mark for one impact with seeded spikes radiating outward.
+     *
+     * @param decal DECAL_STRIDE floats from decals_
+     */
+    void drawDecalOnTexture(const float* decal);
+
+    /**
+     * @brief Grow the dirty rectangle to cover texels [min_x, max_x) x [min_y, max_y)
+     */
+    void markDirty(int min_x, int min_y, int max_x, int max_y);
+
+    /**
+     * @brief First texel of the texture (own buffer or atlas region)
+     */
+    uint8_t* textureData() { return shared_texture_data_ ? shared_texture_data_ : texture_buffer_.data(); }
+
+    /**
+     * @brief Fill with paint and redraw every decal
+     */
+    void repaintTexture();
+
+    /**
+     * @brief Draw into a SteelTextureAtlas region instead of texture_buffer_
+     *
+     * @param data First texel of the region
+     * @param row_bytes Bytes between rows of the atlas page
+     * @param texture_size Region height; the width is twice this
+     */
+    void bindTextureStorage(uint8_t* data, size_t row_bytes, int texture_size);
+
+    /**
+     * @brief Return to an own texture_buffer_ of the current size
+     */
+    void unbindTextureStorage();
+
+    /**
+     * @brief Size mip_buffer_ for the current texture, or free it when mipmaps are off
+     */
+    void allocateMips();
+
+    /**
+     * @brief Re-filter all mip levels over base texels [min_x, max_x) x [min_y, max_y)
      */
-    void drawImpactOnTexture(const btk::math::Vector3D& local_position, float bullet_diameter, bool is_front_face);
+    void updateMips(int min_x, int min_y, int max_x, int max_y);
 
     /**
      * @brief Calculate transfer ratio based on impact angle
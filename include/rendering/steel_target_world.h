@@ -0,0 +1,143 @@
+#pragma once
+
+#include "ballistics/bullet.h"
+#include "math/simd.h"
+#include "rendering/steel_target.h"
+#include <cstdint>
+#include <vector>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten/val.h>
+#endif
+
+namespace btk::rendering
+{
+
+  /**
+   * @brief Steps the physics of many SteelTargets together.
+   *
+   * Targets are registered once; each step() gathers the awake ones into
+   * SIMD-width SoA blocks, runs every substep over the blocks (same models as
+   * SteelTarget::timeStep, grouped by each target's chain solver), and writes
+   * the state back. Settled targets are dropped from the awake list and cost
+   * nothing until wake() or hit() is called for them, so a whole steel range
+   * costs one call per frame.
+   *
+   * The world does not own the targets; a registered target must be removed
+   * before it is destroyed.
+   */
+  class SteelTargetWorld
+  {
+    public:
+    static constexpr int WIDTH = btk::math::simd::NATIVE_WIDTH; ///< Targets per block
+
+    /**
+     * @brief Register a target (awake if it is moving).
+     * @return Target index, stable until the target is removed
+     * @throws std::invalid_argument if target is null
+     */
+    int addTarget(SteelTarget* target);
+
+    /**
+     * @brief Unregister a target; its index may be reused by a later addTarget().
+     * @throws std::invalid_argument if index is not a registered target
+     */
+    void removeTarget(int index);
+
+    /// Unregister all targets
+    void clear();
+
+    /**
+     * @brief Put a target back on the awake list (e.g. after an external impulse).
+     * @throws std::invalid_argument if index is not a registered target
+     */
+    void wake(int index);
+
+    /**
+     * @brief Apply a bullet hit to a target and wake it.
+     * @throws std::invalid_argument if index is not a registered target
+     */
+    void hit(int index, const btk::ballistics::Bullet& bullet);
+
+    /**
+     * @brief Advance all awake targets.
+     *
+     * @param dt Time step in seconds (clamped to 1 s, subdivided per chain solver like SteelTarget::timeStep)
+     * @return Number of targets still awake
+     */
+    int step(float dt);
+
+    /// Number of registered targets
+    int getTargetCount() const { return target_count_; }
+
+    /// Number of awake targets
+    int getAwakeCount() const { return static_cast<int>(awake_.size()); }
+
+    /**
+     * @brief Indices of awake targets as of the last step()/wake()/hit().
+     *
+     * Returns a zero-copy Int32Array view; it is invalidated by the next
+     * call that changes the awake list.
+     */
+#ifdef __EMSCRIPTEN__
+    emscripten::val getAwakeIndices() const;
+#else
+    const std::vector<int32_t>& getAwakeIndices() const { return awake_; }
+#endif
+
+    private:
+    /// Rigid-body state of WIDTH targets
+    struct Block
+    {
+      btk::math::simd::vfloat pos_x, pos_y, pos_z;
+      btk::math::simd::vfloat vel_x, vel_y, vel_z;
+      btk::math::simd::vfloat ang_x, ang_y, ang_z;
+      btk::math::simd::vfloat q_w, q_x, q_y, q_z;
+      btk::math::simd::vfloat inv_mass;
+      btk::math::simd::vfloat inv_inertia_x, inv_inertia_y, inv_inertia_z;
+      uint32_t first_anchor; ///< First AnchorBlock of this block
+      uint32_t anchor_count; ///< Most anchors of any lane
+    };
+
+    /// k-th chain anchor of each lane in a Block
+    struct AnchorBlock
+    {
+      btk::math::simd::vfloat local_x, local_y, local_z;
+      btk::math::simd::vfloat fixed_x, fixed_y, fixed_z;
+      btk::math::simd::vfloat rest_length;
+      btk::math::simd::vint active; ///< All bits set where the lane has this anchor
+    };
+
+    /// Damping factors cached for the last substep length of one solver
+    struct DampingFactors
+    {
+      float substep_dt = -1.0f;
+      float linear = 1.0f;
+      float angular = 1.0f;
+    };
+
+    std::vector<SteelTarget*> targets_; ///< Null for free slots
+    std::vector<int32_t> free_slots_;
+    std::vector<uint8_t> is_awake_;
+    std::vector<int32_t> awake_;
+    int target_count_ = 0;
+
+    // Per-step scratch, kept to avoid reallocating every frame
+    std::vector<Block> blocks_; ///< SPRING blocks first, then IMPLICIT blocks
+    std::vector<AnchorBlock> anchor_blocks_;
+    std::vector<int32_t> lane_targets_; ///< Target index per block lane (-1 for padding)
+    size_t spring_block_count_ = 0;
+
+    DampingFactors spring_damping_;
+    DampingFactors implicit_damping_;
+
+    void checkIndex(int index) const;
+    void gather();
+    void gatherLane(Block& block, int lane, const SteelTarget& target);
+    void scatter(float dt);
+    void stepBlocks(size_t first, size_t last, float dt, SteelTarget::ChainSolver solver, DampingFactors& damping);
+    void springSubstep(Block& block, float dt, const DampingFactors& damping) const;
+    void implicitSubstep(Block& block, float dt, const DampingFactors& damping) const;
+  };
+
+} // namespace btk::rendering
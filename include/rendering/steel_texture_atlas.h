@@ -0,0 +1,159 @@
+#pragma once
+
+#include "rendering/steel_target.h"
+#include <cstdint>
+#include <vector>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten/val.h>
+#endif
+
+namespace btk::rendering
+{
+
+  /**
+   * @brief Packs the paint textures of many SteelTargets into shared RGBA pages.
+   *
+   * Each registered target gets a (2 * size) x size region on a square page and
+   * draws its impact marks there instead of into its own buffer. Pages are
+   * stored back to back in one buffer, laid out as the layers of a texture
+   * array, so a whole steel range needs one texture (one bind, one zero-copy
+   * view) instead of one per plate. Regions are packed on shelves; a new page
+   * is added only when no shelf has room.
+   *
+   * The atlas does not own the targets; a registered target must be removed
+   * before it is destroyed, and the atlas must outlive its targets' use of
+   * the texture.
+   */
+  class SteelTextureAtlas
+  {
+    public:
+    /**
+     * @brief Texel rectangle of a target on an atlas page
+     */
+    struct Region
+    {
+      int page_;   ///< Page index
+      int x_;      ///< Left column
+      int y_;      ///< Top row
+      int width_;  ///< Width in texels (2x height: front half, back half)
+      int height_; ///< Height in texels
+
+      Region() : page_(0), x_(0), y_(0), width_(0), height_(0) {}
+    };
+
+    /**
+     * @brief Normalised texture coordinates of a region on its page
+     */
+    struct UVRect
+    {
+      float u_;      ///< Left edge
+      float v_;      ///< Top edge
+      float width_;  ///< Width in UV units
+      float height_; ///< Height in UV units
+
+      UVRect() : u_(0.0f), v_(0.0f), width_(0.0f), height_(0.0f) {}
+    };
+
+    /**
+     * @brief Create an empty atlas
+     * @param page_size Width and height of each page in texels (default 2048)
+     * @throws std::invalid_argument if page_size is not positive
+     */
+    explicit SteelTextureAtlas(int page_size = 2048);
+
+    /**
+     * @brief Move a target's texture into the atlas
+     *
+     * The region is painted and the target's existing decals are replayed;
+     * the target's own texture buffer is released.
+     *
+     * @param target Target to register
+     * @param texture_size Region height in texels (width is twice this), e.g. from SteelTarget::textureSizeFor()
+     * @return Target index, stable until the target is removed
+     * @throws std::invalid_argument if target is null or the region does not fit on a page
+     */
+    int addTarget(SteelTarget* target, int texture_size);
+
+    /**
+     * @brief Give a target back its own texture buffer and free its region
+     * @throws std::invalid_argument if index is not a registered target
+     */
+    void removeTarget(int index);
+
+    /// Remove all targets and release every page
+    void clear();
+
+    /**
+     * @brief Region of a registered target
+     * @throws std::invalid_argument if index is not a registered target
+     */
+    Region getRegion(int index) const;
+
+    /**
+     * @brief UV rectangle of a registered target on its page
+     * @throws std::invalid_argument if index is not a registered target
+     */
+    UVRect getUVRect(int index) const;
+
+    /// Number of registered targets
+    int getTargetCount() const { return target_count_; }
+
+    /// Number of pages
+    int getPageCount() const { return page_count_; }
+
+    /// Page width and height in texels
+    int getPageSize() const { return page_size_; }
+
+    /**
+     * @brief RGBA texels of all pages (page-major, page_size x page_size each)
+     *
+     * Returns a zero-copy Uint8Array view; it is invalidated when a page is
+     * added and by clear().
+     */
+#ifdef __EMSCRIPTEN__
+    emscripten::val getTexels() const;
+#else
+    const std::vector<uint8_t>& getTexels() const { return texels_; }
+#endif
+
+    /**
+     * @brief Full-width rows y .. y + height - 1 of a page as a zero-copy view
+     *
+     * For uploading a target's dirty rectangle (offset by its region).
+     *
+     * @throws std::invalid_argument if page or the row range is out of range
+     */
+#ifdef __EMSCRIPTEN__
+    emscripten::val getPageRows(int page, int y, int height) const;
+#endif
+
+    private:
+    /// Row of regions of equal or smaller height
+    struct Shelf
+    {
+      int page;
+      int y;
+      int height;
+      int next_x;
+    };
+
+    int page_size_;
+    int page_count_ = 0;
+    std::vector<uint8_t> texels_; ///< All pages, page-major
+    std::vector<int> page_next_y_; ///< First row below the last shelf of each page
+    std::vector<Shelf> shelves_;
+    std::vector<Region> free_regions_; ///< Regions of removed targets, reused by size
+
+    std::vector<SteelTarget*> targets_; ///< Null for free slots
+    std::vector<Region> regions_;
+    std::vector<int32_t> free_slots_;
+    int target_count_ = 0;
+
+    void checkIndex(int index) const;
+    Region allocate(int width, int height);
+    uint8_t* regionOrigin(const Region& region);
+    void addPage();
+  };
+
+} // namespace btk::rendering
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "math/simd.h"
+#include "math/vector.h"
+#include <cstdint>
+#include <vector>
+
+namespace btk::rendering
+{
+
+  /**
+   * @brief Triangles pre-baked into SIMD-width SoA blocks for packet intersection.
+   *
+   * Triangles are grouped into ranges of consecutive triangles (e.g. BVH
+   * leaves); each range starts a new block and stores its triangles as
+   * (v0, edge1, edge2) lanes, so a range is tested block by block with a
+   * branch-free Möller–Trumbore kernel. Padding lanes hold degenerate
+   * triangles that never hit.
+   */
+  class TriangleBlocks
+  {
+    public:
+    static constexpr int WIDTH = btk::math::simd::NATIVE_WIDTH; ///< Triangles per block
+
+    /**
+     * @brief Consecutive triangles tested together.
+     */
+    struct Range
+    {
+      uint32_t first; ///< First triangle
+      uint32_t count; ///< Number of triangles
+    };
+
+    /**
+     * @brief Bake triangles from indexed geometry.
+     *
+     * @param vertices Mesh vertices
+     * @param indices  Triangle indices (3 per triangle)
+     * @param ranges   Non-overlapping triangle ranges to bake (each starts a new block)
+     */
+    void bake(const std::vector<btk::math::Vector3D>& vertices, const std::vector<uint32_t>& indices, const std::vector<Range>& ranges);
+
+    /**
+     * @brief Nearest hit of the segment origin + t * dir (t in [0, 1]) within a baked range.
+     *
+     * @param origin       Segment start
+     * @param dir          Segment direction (t = 1 at segment end)
+     * @param first        First triangle of a range passed to bake()
+     * @param count        Number of triangles in that range
+     * @param t_max        In: only hits with t < t_max count; out: t of the nearest hit
+     * @param hit_triangle Out: triangle number of the nearest hit
+     * @return True if a hit closer than the incoming t_max was found
+     */
+    bool intersect(const btk::math::Vector3D& origin, const btk::math::Vector3D& dir, uint32_t first, uint32_t count, float& t_max, uint32_t& hit_triangle) const;
+
+    private:
+    struct Block
+    {
+      btk::math::simd::vfloat v0_x, v0_y, v0_z;
+      btk::math::simd::vfloat e1_x, e1_y, e1_z;
+      btk::math::simd::vfloat e2_x, e2_y, e2_z;
+    };
+
+    std::vector<Block> blocks_;
+    std::vector<uint32_t> range_block_; ///< First block of the range starting at each triangle
+  };
+
+} // namespace btk::rendering
@@ -0,0 +1,163 @@
+#include "ballistics/performance_matrix.h"
+#include "ballistics/simulator.h"
+#include "ballistics/trajectory_observer.h"
+#include "internal/workers.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace btk::ballistics
+{
+
+  namespace
+  {
+    using btk::internal::resolveThreadCount;
+    using btk::internal::runWorkers;
+
+    constexpr float MAX_FLIGHT_TIME = 60.0f; // s
+
+    // Records the state where the trajectory crosses a distance, then stops the simulation.
+    // If the distance is never reached the last point is kept, like Trajectory::atDistance
+    class RangeCrossing : public TrajectoryObserver
+    {
+      public:
+      explicit RangeCrossing(float range) : range_(range) {}
+
+      bool onPoint(const TrajectoryPoint& point) override
+      {
+        const float distance = point.getDistance();
+        const btk::math::Vector3D& position = point.getPosition();
+        const btk::math::Vector3D& velocity = point.getState().getVelocity();
+
+        if(distance >= range_ && has_point_ && distance > distance_)
+        {
+          const float t = (range_ - distance_) / (distance - distance_);
+          position_ = position_.lerp(position, t);
+          velocity_ = velocity_.lerp(velocity, t);
+          return false;
+        }
+
+        has_point_ = true;
+        distance_ = distance;
+        position_ = position;
+        velocity_ = velocity;
+        return distance < range_;
+      }
+
+      const btk::math::Vector3D& getPosition() const { return position_; }
+      const btk::math::Vector3D& getVelocity() const { return velocity_; }
+
+      private:
+      float range_;
+      bool has_point_ = false;
+      float distance_ = 0.0f;
+      btk::math::Vector3D position_;
+      btk::math::Vector3D velocity_;
+    };
+
+    // Angle subtended by offset_m at range_m in mrad, unsigned
+    float toMrad(float offset_m, float range_m) { return std::atan(std::abs(offset_m) / range_m) * 1000.0f; }
+  } // namespace
+
+  PerformanceMatrix::PerformanceMatrix(const Bullet& bullet, const btk::physics::Atmosphere& atmosphere, float range, float crosswind, float timestep)
+    : bullet_(bullet), atmosphere_(atmosphere), range_(range), crosswind_(crosswind), timestep_(timestep)
+  {
+    if(!(range > 0.0f))
+    {
+      throw std::invalid_argument("PerformanceMatrix range must be positive");
+    }
+    if(!(timestep > 0.0f))
+    {
+      throw std::invalid_argument("PerformanceMatrix timestep must be positive");
+    }
+  }
+
+  void PerformanceMatrix::compute(const float* bcs, size_t bc_count, const float* mvs, size_t mv_count, int thread_count)
+  {
+    for(size_t i = 0; i < bc_count; ++i)
+    {
+      if(!(bcs[i] > 0.0f))
+      {
+        throw std::invalid_argument("PerformanceMatrix BCs must be positive");
+      }
+    }
+    for(size_t j = 0; j < mv_count; ++j)
+    {
+      if(!(mvs[j] > 0.0f))
+      {
+        throw std::invalid_argument("PerformanceMatrix MVs must be positive");
+      }
+    }
+
+    bc_count_ = static_cast<int>(bc_count);
+    mv_count_ = static_cast<int>(mv_count);
+    const size_t cell_count = bc_count * mv_count;
+    drift_.assign(cell_count, 0.0f);
+    drop_.assign(cell_count, 0.0f);
+    sensitivity_.assign(cell_count, 0.0f);
+    velocity_.assign(cell_count, 0.0f);
+    energy_.assign(cell_count, 0.0f);
+
+    const btk::math::Vector3D calm(0.0f, 0.0f, 0.0f);
+    const btk::math::Vector3D crosswind(-crosswind_, 0.0f, 0.0f); // From 3 o'clock
+    const float mass = bullet_.getWeight();
+
+    // Cells are interleaved across workers: slow (low BC, low MV) cells cluster in one
+    // corner of the grid, so contiguous blocks would leave some workers idle
+    const int worker_count = resolveThreadCount(thread_count, cell_count);
+    runWorkers(worker_count,
+               [&](int worker)
+               {
+                 Simulator simulator;
+                 simulator.setAtmosphere(atmosphere_);
+
+                 // Fire level from the origin and return the state at range
+                 auto fire = [&](const Bullet& bullet, float mv, const btk::math::Vector3D& wind)
+                 {
+                   RangeCrossing crossing(range_);
+                   simulator.setInitialBullet(Bullet(bullet, btk::math::Vector3D(0.0f, 0.0f, 0.0f), btk::math::Vector3D(0.0f, 0.0f, -mv), 0.0f));
+                   simulator.setWind(wind);
+                   simulator.simulate(range_, timestep_, MAX_FLIGHT_TIME, crossing);
+                   return crossing;
+                 };
+
+                 for(size_t cell = static_cast<size_t>(worker); cell < cell_count; cell += static_cast<size_t>(worker_count))
+                 {
+                   const Bullet bullet(bullet_.getWeight(), bullet_.getDiameter(), bullet_.getLength(), bcs[cell / mv_count], bullet_.getDragFunction());
+                   const float mv = mvs[cell % mv_count];
+
+                   const RangeCrossing still_air = fire(bullet, mv, calm);
+                   const float speed = still_air.getVelocity().magnitude();
+                   drop_[cell] = toMrad(still_air.getPosition().y, range_);
+                   velocity_[cell] = speed;
+                   energy_[cell] = 0.5f * mass * speed * speed;
+
+                   drift_[cell] = toMrad(fire(bullet, mv, crosswind).getPosition().x, range_);
+
+                   const float slow_drop = toMrad(fire(bullet, mv * (1.0f - 0.5f * MV_SPREAD), calm).getPosition().y, range_);
+                   const float fast_drop = toMrad(fire(bullet, mv * (1.0f + 0.5f * MV_SPREAD), calm).getPosition().y, range_);
+                   sensitivity_[cell] = std::abs(slow_drop - fast_drop);
+                 }
+               });
+  }
+
+#ifdef __EMSCRIPTEN__
+  void PerformanceMatrix::computeGrid(emscripten::val bcs_val, emscripten::val mvs_val, int thread_count)
+  {
+    const std::vector<float> bcs = emscripten::convertJSArrayToNumberVector<float>(bcs_val);
+    const std::vector<float> mvs = emscripten::convertJSArrayToNumberVector<float>(mvs_val);
+    compute(bcs.data(), bcs.size(), mvs.data(), mvs.size(), thread_count);
+  }
+
+  emscripten::val PerformanceMatrix::getDrift() const { return emscripten::val(emscripten::typed_memory_view(drift_.size(), drift_.data())); }
+
+  emscripten::val PerformanceMatrix::getDrop() const { return emscripten::val(emscripten::typed_memory_view(drop_.size(), drop_.data())); }
+
+  emscripten::val PerformanceMatrix::getSensitivity() const { return emscripten::val(emscripten::typed_memory_view(sensitivity_.size(), sensitivity_.data())); }
+
+  emscripten::val PerformanceMatrix::getVelocity() const { return emscripten::val(emscripten::typed_memory_view(velocity_.size(), velocity_.data())); }
+
+  emscripten::val PerformanceMatrix::getEnergy() const { return emscripten::val(emscripten::typed_memory_view(energy_.size(), energy_.data())); }
+#endif
+
+} // namespace btk::ballistics
@@ -0,0 +1,278 @@
+#include "ballistics/range_table.h"
+#include "ballistics/trajectory_observer.h"
+#include "math/conversions.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten/val.h>
+#endif
+
+namespace btk::ballistics
+{
+
+  namespace
+  {
+    constexpr float MAX_FLIGHT_TIME = 60.0f; // s
+
+    // Calls write(row, time, position, velocity) as the trajectory crosses each row's range,
+    // interpolating between steps like StationRecorder but without keeping any points
+    template <typename Write>
+    class RowWriter : public TrajectoryObserver
+    {
+      public:
+      RowWriter(const float* data, size_t rows, Write& write) : data_(data), rows_(rows), write_(write) {}
+
+      bool onPoint(const TrajectoryPoint& point) override
+      {
+        const float distance = point.getDistance();
+        const btk::math::Vector3D& position = point.getPosition();
+        const btk::math::Vector3D& velocity = point.getState().getVelocity();
+
+        while(next_ < rows_ && range(next_) <= distance)
+        {
+          const float station = range(next_);
+
+          // Ranges before the first point clamp to it, like Trajectory::atDistance
+          if(!has_previous_ || station <= previous_distance_)
+          {
+            if(has_previous_)
+            {
+              write_(next_, previous_time_, previous_position_, previous_velocity_);
+            }
+            else
+            {
+              write_(next_, point.getTime(), position, velocity);
+            }
+            ++next_;
+            continue;
+          }
+
+          const float t = (station - previous_distance_) / (distance - previous_distance_);
+          write_(next_, previous_time_ + t * (point.getTime() - previous_time_), previous_position_.lerp(position, t), previous_velocity_.lerp(velocity, t));
+          ++next_;
+        }
+
+        has_previous_ = true;
+        previous_distance_ = distance;
+        previous_time_ = point.getTime();
+        previous_position_ = position;
+        previous_velocity_ = velocity;
+        return next_ < rows_;
+      }
+
+      /// Rows written so far
+      size_t getWritten() const { return next_; }
+
+      private:
+      float range(size_t row) const { return data_[row * RangeTable::STRIDE + RangeTable::FIELD_RANGE]; }
+
+      const float* data_;
+      size_t rows_;
+      Write& write_;
+      size_t next_ = 0;
+      bool has_previous_ = false;
+      float previous_distance_ = 0.0f;
+      float previous_time_ = 0.0f;
+      btk::math::Vector3D previous_position_;
+      btk::math::Vector3D previous_velocity_;
+    };
+  } // namespace
+
+  RangeTable::RangeTable(const Bullet& bullet, float muzzle_velocity, float zero_range, float scope_height, const btk::physics::Atmosphere& atmosphere, const btk::math::Vector3D& wind,
+                         float spin_rate, AngleUnit unit, float timestep)
+    : zeroed_bullet_(bullet), wind_(wind), scope_height_(scope_height), timestep_(timestep), unit_(unit)
+  {
+    if(!(muzzle_velocity > 0.0f))
+    {
+      throw std::invalid_argument("RangeTable muzzle_velocity must be positive");
+    }
+    if(!(zero_range > 0.0f))
+    {
+      throw std::invalid_argument("RangeTable zero_range must be positive");
+    }
+    if(!(timestep > 0.0f))
+    {
+      throw std::invalid_argument("RangeTable timestep must be positive");
+    }
+
+    // Zero in still air: bore at the origin, line of sight scope_height above it
+    simulator_.setInitialBullet(bullet);
+    simulator_.setAtmosphere(atmosphere);
+    simulator_.setWind(btk::math::Vector3D(0.0f, 0.0f, 0.0f));
+    zeroed_bullet_ = simulator_.computeZero(muzzle_velocity, btk::math::Vector3D(0.0f, scope_height, -zero_range), timestep, 50, 1e-4f, spin_rate);
+  }
+
+  void RangeTable::build(float max_range, float step)
+  {
+    if(!(step > 0.0f))
+    {
+      throw std::invalid_argument("RangeTable step must be positive");
+    }
+    if(!(max_range >= 0.0f))
+    {
+      throw std::invalid_argument("RangeTable max_range must not be negative");
+    }
+
+    const size_t rows = static_cast<size_t>(std::floor(max_range / step + 1e-4f)) + 1;
+    data_.assign(rows * STRIDE, std::numeric_limits<float>::quiet_NaN());
+    for(size_t i = 0; i < rows; ++i)
+    {
+      data_[i * STRIDE + FIELD_RANGE] = static_cast<float>(i) * step;
+    }
+    fill();
+  }
+
+  void RangeTable::buildAt(const float* ranges, size_t count)
+  {
+    for(size_t i = 0; i < count; ++i)
+    {
+      if(!(ranges[i] >= 0.0f) || (i > 0 && ranges[i] < ranges[i - 1]))
+      {
+        throw std::invalid_argument("RangeTable ranges must be non-negative and ascending");
+      }
+    }
+
+    data_.assign(count * STRIDE, std::numeric_limits<float>::quiet_NaN());
+    for(size_t i = 0; i < count; ++i)
+    {
+      data_[i * STRIDE + FIELD_RANGE] = ranges[i];
+    }
+    fill();
+  }
+
+#ifdef __EMSCRIPTEN__
+  void RangeTable::buildAt(emscripten::val ranges_val)
+  {
+    const std::vector<float> ranges = emscripten::convertJSArrayToNumberVector<float>(ranges_val);
+    buildAt(ranges.data(), ranges.size());
+  }
+#endif
+
+  template <typename Write>
+  size_t RangeTable::run(const btk::math::Vector3D& wind, Write&& write)
+  {
+    const size_t rows = data_.size() / STRIDE;
+    if(rows == 0)
+    {
+      return 0;
+    }
+
+    simulator_.setInitialBullet(zeroed_bullet_);
+    simulator_.setWind(wind);
+    RowWriter<Write> writer(data_.data(), rows, write);
+    simulator_.simulate(data_[(rows - 1) * STRIDE + FIELD_RANGE], timestep_, MAX_FLIGHT_TIME, writer);
+    return writer.getWritten();
+  }
+
+  void RangeTable::fill()
+  {
+    const size_t rows = data_.size() / STRIDE;
+    const float mass = zeroed_bullet_.getWeight();
+    const btk::math::Vector3D calm(0.0f, 0.0f, 0.0f);
+    const bool is_calm = wind_.x == 0.0f && wind_.y == 0.0f && wind_.z == 0.0f;
+    const bool record_calm = extended_columns_ && is_calm;
+
+    // Until the angles are computed, FIELD_SPIN_DRIFT / FIELD_JUMP_PER_MPH hold the
+    // still-air x / y position that the reference crosswind run is measured against
+    auto record_still_air = [this](size_t row, const btk::math::Vector3D& position)
+    {
+      float* r = data_.data() + row * STRIDE;
+      r[FIELD_SPIN_DRIFT] = position.x;
+      r[FIELD_JUMP_PER_MPH] = position.y;
+    };
+
+    // Run in the given wind (doubles as the still-air run when calm and extended)
+    run(wind_,
+        [&](size_t row, float time, const btk::math::Vector3D& position, const btk::math::Vector3D& velocity)
+        {
+          float* r = data_.data() + row * STRIDE;
+          const float speed = velocity.magnitude();
+          r[FIELD_DROP] = position.y - scope_height_;
+          r[FIELD_WINDAGE] = position.x;
+          r[FIELD_TIME] = time;
+          r[FIELD_VELOCITY] = speed;
+          r[FIELD_ENERGY] = 0.5f * mass * speed * speed;
+          if(record_calm)
+          {
+            record_still_air(row, position);
+          }
+        });
+
+    // Extended columns: still-air run (unless the wind run was one) and reference crosswind run
+    size_t crosswind_rows = 0;
+    if(extended_columns_)
+    {
+      if(!is_calm)
+      {
+        run(calm, [&](size_t row, float, const btk::math::Vector3D& position, const btk::math::Vector3D&) { record_still_air(row, position); });
+      }
+
+      // Full-value crosswind toward +X, relative to still air
+      crosswind_rows = run(btk::math::Vector3D(btk::math::Conversions::mphToMps(REFERENCE_CROSSWIND_MPH), 0.0f, 0.0f),
+                           [&](size_t row, float, const btk::math::Vector3D& position, const btk::math::Vector3D&)
+                           {
+                             float* r = data_.data() + row * STRIDE;
+                             r[FIELD_WINDAGE_PER_MPH] = (position.x - r[FIELD_SPIN_DRIFT]) / REFERENCE_CROSSWIND_MPH;
+                             r[FIELD_JUMP_PER_MPH] = (position.y - r[FIELD_JUMP_PER_MPH]) / REFERENCE_CROSSWIND_MPH;
+                           });
+    }
+
+    for(size_t row = 0; row < rows; ++row)
+    {
+      float* r = data_.data() + row * STRIDE;
+      const float range = r[FIELD_RANGE];
+      r[FIELD_DROP_ANGLE] = toAngle(r[FIELD_DROP], range);
+      r[FIELD_WINDAGE_ANGLE] = toAngle(r[FIELD_WINDAGE], range);
+      if(extended_columns_)
+      {
+        if(row >= crosswind_rows)
+        {
+          r[FIELD_JUMP_PER_MPH] = std::numeric_limits<float>::quiet_NaN();
+        }
+        r[FIELD_WINDAGE_PER_MPH] = toAngle(r[FIELD_WINDAGE_PER_MPH], range);
+        r[FIELD_SPIN_DRIFT] = toAngle(r[FIELD_SPIN_DRIFT], range);
+        r[FIELD_JUMP_PER_MPH] = toAngle(r[FIELD_JUMP_PER_MPH], range);
+      }
+    }
+  }
+
+  float RangeTable::toAngle(float offset_m, float range_m) const
+  {
+    if(range_m <= 0.0f)
+    {
+      return std::isnan(offset_m) ? offset_m : 0.0f;
+    }
+    const float angle = std::atan2(offset_m, range_m);
+    return unit_ == MOA ? btk::math::Conversions::radiansToMoa(angle) : btk::math::Conversions::radiansToMrad(angle);
+  }
+
+  RangeTable::Row RangeTable::getRow(int index) const
+  {
+    if(index < 0 || index >= getRowCount())
+    {
+      throw std::invalid_argument("RangeTable row index out of range");
+    }
+
+    const float* r = data_.data() + static_cast<size_t>(index) * STRIDE;
+    Row row;
+    row.range_ = r[FIELD_RANGE];
+    row.drop_ = r[FIELD_DROP];
+    row.drop_angle_ = r[FIELD_DROP_ANGLE];
+    row.windage_ = r[FIELD_WINDAGE];
+    row.windage_angle_ = r[FIELD_WINDAGE_ANGLE];
+    row.windage_per_mph_ = r[FIELD_WINDAGE_PER_MPH];
+    row.spin_drift_ = r[FIELD_SPIN_DRIFT];
+    row.jump_per_mph_ = r[FIELD_JUMP_PER_MPH];
+    row.time_ = r[FIELD_TIME];
+    row.velocity_ = r[FIELD_VELOCITY];
+    row.energy_ = r[FIELD_ENERGY];
+    return row;
+  }
+
+#ifdef __EMSCRIPTEN__
+  emscripten::val RangeTable::getData() const { return emscripten::val(emscripten::typed_memory_view(data_.size(), data_.data())); }
+#endif
+
+} // namespace btk::ballistics
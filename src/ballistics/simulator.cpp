@@ -1,6 +1,7 @@
 #include "ballistics/simulator.h"
 #include "math/conversions.h"
 #include "physics/constants.h"
+#include "profiling/profiler.h"
 #include <algorithm>
 #include <array>
 #include <cmath>
@@ -285,57 +286,121 @@ namespace btk::ballistics
     return initial_bullet_;
   }
 
-  // Simulate trajectory using stored state
-  void Simulator::simulate(float max_distance, float dt, float max_time)
+  namespace
   {
-    // Add initial point with current wind
-    trajectory_.addPoint(current_time_, current_bullet_, wind_);
-
-    float start_time = current_time_;
-    float max_sim_time = start_time + max_time;
+    // Wind field returning the simulator's constant wind vector
+    struct ConstantWind
+    {
+      const btk::math::Vector3D& wind;
+      btk::math::Vector3D operator()(float, float, float) const { return wind; }
+    };
 
-    while(current_time_ < max_sim_time)
+    // Point sink appending to a stored trajectory
+    struct TrajectoryRecorder
     {
-      timeStep(dt);
-      if(-current_bullet_.getPositionZ() > max_distance)
-        break;
-    }
-  }
+      Trajectory& trajectory;
+      bool operator()(float time, const Bullet& bullet, const btk::math::Vector3D& wind) const
+      {
+        trajectory.addPoint(time, bullet, wind);
+        return true;
+      }
+    };
 
-  // Simulate trajectory with wind generator sampling
-  void Simulator::simulate(float max_distance, float dt, float max_time, const btk::physics::WindGenerator& wind_gen)
+    // Point sink forwarding to a streaming observer
+    struct ObserverSink
+    {
+      TrajectoryObserver& observer;
+      bool operator()(float time, const Bullet& bullet, const btk::math::Vector3D& wind) const { return observer.onPoint(TrajectoryPoint(time, bullet, wind)); }
+    };
+  } // namespace
+
+  // Simulate trajectory with wind field sampling
+  template <typename WindField, typename PointSink>
+  void Simulator::simulateInWindField(float max_distance, float dt, float max_time, const WindField& wind_field, PointSink&& sink)
   {
-    // Sample wind at initial position (wind_gen expects: crossrange, vertical, -downrange)
+    BTK_PROFILE_SCOPE(TRAJECTORY);
+
+    // Sample wind at initial position (wind field expects: crossrange, vertical, -downrange)
     float x = current_bullet_.getPositionX();
     float y = current_bullet_.getPositionY();
     float z = current_bullet_.getPositionZ();
-    wind_ = wind_gen(x, y, z);
+    wind_ = wind_field(x, y, z);
 
     // Add initial point with wind
-    trajectory_.addPoint(current_time_, current_bullet_, wind_);
+    if(!sink(current_time_, current_bullet_, wind_))
+      return;
 
     float start_time = current_time_;
     float max_sim_time = start_time + max_time;
 
     while(current_time_ < max_sim_time)
     {
-      // Sample wind at current position (before stepping) (wind_gen expects: crossrange, vertical, -downrange)
+      // Sample wind at current position (before stepping) (wind field expects: crossrange, vertical, -downrange)
       float x = current_bullet_.getPositionX();
       float y = current_bullet_.getPositionY();
       float z = current_bullet_.getPositionZ();
-      wind_ = wind_gen(x, y, z);
+      wind_ = wind_field(x, y, z);
 
       // Step forward (uses wind_ for acceleration calculation)
-      timeStep(dt);
+      integrateStep(dt);
+
+      if(!sink(current_time_, current_bullet_, wind_))
+        break;
 
       if(-current_bullet_.getPositionZ() > max_distance)
         break;
     }
   }
 
+  // Simulate trajectory using stored state
+  void Simulator::simulate(float max_distance, float dt, float max_time) { simulateInWindField(max_distance, dt, max_time, ConstantWind{wind_}, TrajectoryRecorder{trajectory_}); }
+
+  // Simulate trajectory with wind generator sampling
+  void Simulator::simulate(float max_distance, float dt, float max_time, const btk::physics::WindGenerator& wind_gen)
+  {
+    simulateInWindField(max_distance, dt, max_time, wind_gen, TrajectoryRecorder{trajectory_});
+  }
+
+  // Simulate trajectory with level-of-detail wind sampling
+  void Simulator::simulate(float max_distance, float dt, float max_time, const btk::physics::WindLodSampler& wind_sampler)
+  {
+    simulateInWindField(max_distance, dt, max_time, wind_sampler, TrajectoryRecorder{trajectory_});
+  }
+
+  // Streaming variants: points go to the observer, not the stored trajectory. The stored
+  // trajectory is cleared so it never holds points from an earlier run that no longer
+  // match the simulator state
+  void Simulator::simulate(float max_distance, float dt, float max_time, TrajectoryObserver& observer)
+  {
+    trajectory_.clear();
+    simulateInWindField(max_distance, dt, max_time, ConstantWind{wind_}, ObserverSink{observer});
+  }
+
+  void Simulator::simulate(float max_distance, float dt, float max_time, const btk::physics::WindGenerator& wind_gen, TrajectoryObserver& observer)
+  {
+    trajectory_.clear();
+    simulateInWindField(max_distance, dt, max_time, wind_gen, ObserverSink{observer});
+  }
+
+  void Simulator::simulate(float max_distance, float dt, float max_time, const btk::physics::WindLodSampler& wind_sampler, TrajectoryObserver& observer)
+  {
+    trajectory_.clear();
+    simulateInWindField(max_distance, dt, max_time, wind_sampler, ObserverSink{observer});
+  }
+
   // Time step using stored state
   void Simulator::timeStep(float dt)
   {
+    integrateStep(dt);
+
+    // Add point to trajectory with current wind
+    trajectory_.addPoint(current_time_, current_bullet_, wind_);
+  }
+
+  void Simulator::integrateStep(float dt)
+  {
+    BTK_PROFILE_COUNT(TRAJECTORY_STEPS, 1);
+
     Bullet s0 = current_bullet_;
 
     btk::math::Vector3D a0 = calculateAccelerationFor(s0, dt);
@@ -351,9 +416,6 @@ namespace btk::ballistics
     // Create final state using sHalf (which has updated lag state from midpoint acceleration)
     current_bullet_ = Bullet(sHalf, x1, v1, s0.getSpinRate());
     current_time_ += dt;
-
-    // Add point to trajectory with current wind
-    trajectory_.addPoint(current_time_, current_bullet_, wind_);
   }
 
   // State queries
@@ -7,11 +7,36 @@
 #include <sstream>
 #include <stdexcept>
 
+#ifdef __EMSCRIPTEN__
+#include <emscripten/val.h>
+#endif
+
 namespace btk
 {
   namespace ballistics
   {
 
+    namespace
+    {
+      // Index of the segment [left, left + 1] containing value, which must lie strictly
+      // between the first and last point's key. Steps forward from hint, so ascending
+      // stations cost one pass over the points; searches again if value is behind hint.
+      template <typename Key>
+      size_t findSegment(const std::vector<TrajectoryPoint>& points, float value, size_t hint, Key key)
+      {
+        if(key(points[hint]) > value)
+        {
+          auto it = std::upper_bound(points.begin(), points.end(), value, [&key](float v, const TrajectoryPoint& point) { return v < key(point); });
+          return static_cast<size_t>(it - points.begin()) - 1;
+        }
+        while(key(points[hint + 1]) <= value)
+        {
+          ++hint;
+        }
+        return hint;
+      }
+    } // namespace
+
     // Trajectory implementation
     Trajectory::Trajectory() {}
 
@@ -140,6 +165,99 @@ namespace btk
       return TrajectoryPoint(time, interp_state, wind);
     }
 
+    void Trajectory::sampleAtDistances(const float* distances, size_t count, float* out) const
+    {
+      if(points_.empty())
+      {
+        std::fill(out, out + count * SAMPLE_STRIDE, std::numeric_limits<float>::quiet_NaN());
+        return;
+      }
+
+      const float first_distance = points_.front().getDistance();
+      const float last_distance = points_.back().getDistance();
+      auto distance_of = [](const TrajectoryPoint& point) { return point.getDistance(); };
+
+      size_t left = 0;
+      for(size_t i = 0; i < count; ++i, out += SAMPLE_STRIDE)
+      {
+        const float distance = distances[i];
+
+        // Clamp to the ends, as atDistance() does
+        if(distance >= last_distance)
+        {
+          writeSample(points_.back(), out);
+          continue;
+        }
+        if(distance <= first_distance)
+        {
+          writeSample(points_.front(), out);
+          continue;
+        }
+
+        left = findSegment(points_, distance, left, distance_of);
+        const TrajectoryPoint& point1 = points_[left];
+        const TrajectoryPoint& point2 = points_[left + 1];
+        const float t = (distance - point1.getDistance()) / (point2.getDistance() - point1.getDistance());
+        writeSample(left, t, point1.getTime() + t * (point2.getTime() - point1.getTime()), out);
+      }
+    }
+
+    void Trajectory::sampleAtTimes(const float* times, size_t count, float* out) const
+    {
+      if(points_.empty())
+      {
+        std::fill(out, out + count * SAMPLE_STRIDE, std::numeric_limits<float>::quiet_NaN());
+        return;
+      }
+
+      const float first_time = points_.front().getTime();
+      const float last_time = points_.back().getTime();
+      auto time_of = [](const TrajectoryPoint& point) { return point.getTime(); };
+
+      size_t left = 0;
+      for(size_t i = 0; i < count; ++i, out += SAMPLE_STRIDE)
+      {
+        const float time = times[i];
+
+        // Clamp to the ends, as atTime() does
+        if(time <= first_time)
+        {
+          writeSample(points_.front(), out);
+          continue;
+        }
+        if(time >= last_time)
+        {
+          writeSample(points_.back(), out);
+          continue;
+        }
+
+        left = findSegment(points_, time, left, time_of);
+        const float time1 = points_[left].getTime();
+        const float t = (time - time1) / (points_[left + 1].getTime() - time1);
+        writeSample(left, t, time, out);
+      }
+    }
+
+#ifdef __EMSCRIPTEN__
+    emscripten::val Trajectory::sampleAtDistances(emscripten::val distances_val) const
+    {
+      const std::vector<float> distances = emscripten::convertJSArrayToNumberVector<float>(distances_val);
+      std::vector<float> samples(distances.size() * SAMPLE_STRIDE);
+      sampleAtDistances(distances.data(), distances.size(), samples.data());
+
+      // Copy out of the heap so the result survives memory growth and later calls
+      return emscripten::val::global("Float32Array").new_(emscripten::val(emscripten::typed_memory_view(samples.size(), samples.data())));
+    }
+
+    emscripten::val Trajectory::sampleAtTimes(emscripten::val times_val) const
+    {
+      const std::vector<float> times = emscripten::convertJSArrayToNumberVector<float>(times_val);
+      std::vector<float> samples(times.size() * SAMPLE_STRIDE);
+      sampleAtTimes(times.data(), times.size(), samples.data());
+      return emscripten::val::global("Float32Array").new_(emscripten::val(emscripten::typed_memory_view(samples.size(), samples.data())));
+    }
+#endif
+
     float Trajectory::getTotalDistance() const
     {
       if(points_.empty())
@@ -312,5 +430,41 @@ namespace btk
       return Bullet(state1, pos, vel, spin);
     }
 
+    void Trajectory::writeSample(size_t left, float t, float time, float* out) const
+    {
+      const Bullet& state1 = points_[left].getState();
+      const Bullet& state2 = points_[left + 1].getState();
+
+      const btk::math::Vector3D pos = state1.getPosition().lerp(state2.getPosition(), t);
+      const btk::math::Vector3D vel = state1.getVelocity().lerp(state2.getVelocity(), t);
+      const float speed = vel.magnitude();
+
+      out[SAMPLE_TIME] = time;
+      out[SAMPLE_X] = pos.x;
+      out[SAMPLE_Y] = pos.y;
+      out[SAMPLE_Z] = pos.z;
+      out[SAMPLE_VX] = vel.x;
+      out[SAMPLE_VY] = vel.y;
+      out[SAMPLE_VZ] = vel.z;
+      out[SAMPLE_VELOCITY] = speed;
+      out[SAMPLE_ENERGY] = 0.5f * state1.getWeight() * speed * speed;
+    }
+
+    void Trajectory::writeSample(const TrajectoryPoint& point, float* out)
+    {
+      const btk::math::Vector3D& pos = point.getPosition();
+      const btk::math::Vector3D& vel = point.getState().getVelocity();
+
+      out[SAMPLE_TIME] = point.getTime();
+      out[SAMPLE_X] = pos.x;
+      out[SAMPLE_Y] = pos.y;
+      out[SAMPLE_Z] = pos.z;
+      out[SAMPLE_VX] = vel.x;
+      out[SAMPLE_VY] = vel.y;
+      out[SAMPLE_VZ] = vel.z;
+      out[SAMPLE_VELOCITY] = point.getVelocity();
+      out[SAMPLE_ENERGY] = point.getKineticEnergy();
+    }
+
   } // namespace ballistics
 } // namespace btk
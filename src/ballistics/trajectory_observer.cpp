@@ -0,0 +1,86 @@
+#include "ballistics/trajectory_observer.h"
+#include <algorithm>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten/val.h>
+#endif
+
+namespace btk::ballistics
+{
+
+  StationRecorder::StationRecorder(StationType type) : type_(type) {}
+
+  StationRecorder::StationRecorder(std::vector<float> stations, StationType type) : type_(type), stations_(std::move(stations))
+  {
+    std::sort(stations_.begin(), stations_.end());
+    points_.reserve(stations_.size());
+  }
+
+  void StationRecorder::addStation(float station)
+  {
+    stations_.insert(std::upper_bound(stations_.begin(), stations_.end(), station), station);
+    points_.reserve(stations_.size());
+  }
+
+  void StationRecorder::reset()
+  {
+    points_.clear();
+    previous_.reset();
+  }
+
+  float StationRecorder::stationValue(const TrajectoryPoint& point) const { return type_ == TIME ? point.getTime() : point.getDistance(); }
+
+  bool StationRecorder::onPoint(const TrajectoryPoint& point)
+  {
+    const float value = stationValue(point);
+
+    while(points_.size() < stations_.size() && stations_[points_.size()] <= value)
+    {
+      const float station = stations_[points_.size()];
+
+      // Stations before the first point clamp to it, like Trajectory::atDistance/atTime
+      if(!previous_.has_value() || station <= stationValue(*previous_))
+      {
+        points_.push_back(previous_.has_value() ? *previous_ : point);
+        continue;
+      }
+
+      const TrajectoryPoint& p1 = *previous_;
+      const float t = (station - stationValue(p1)) / (value - stationValue(p1));
+
+      const Bullet& state1 = p1.getState();
+      const Bullet& state2 = point.getState();
+      btk::math::Vector3D pos = state1.getPosition().lerp(state2.getPosition(), t);
+      btk::math::Vector3D vel = state1.getVelocity().lerp(state2.getVelocity(), t);
+      float spin = state1.getSpinRate() + t * (state2.getSpinRate() - state1.getSpinRate());
+      float time = p1.getTime() + t * (point.getTime() - p1.getTime());
+      btk::math::Vector3D wind = p1.getWind().lerp(point.getWind(), t);
+
+      points_.emplace_back(time, Bullet(state1, pos, vel, spin), wind);
+    }
+
+    previous_ = point;
+    return !isComplete();
+  }
+
+  void StationRecorder::getSamples(float* out) const
+  {
+    for(const TrajectoryPoint& point : points_)
+    {
+      Trajectory::writeSample(point, out);
+      out += Trajectory::SAMPLE_STRIDE;
+    }
+  }
+
+#ifdef __EMSCRIPTEN__
+  emscripten::val StationRecorder::getSamples() const
+  {
+    std::vector<float> samples(points_.size() * Trajectory::SAMPLE_STRIDE);
+    getSamples(samples.data());
+
+    // Copy out of the heap so the result survives memory growth and later runs
+    return emscripten::val::global("Float32Array").new_(emscripten::val(emscripten::typed_memory_view(samples.size(), samples.data())));
+  }
+#endif
+
+} // namespace btk::ballistics
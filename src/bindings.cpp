@@ -3,8 +3,11 @@
 
 // Include all our C++ headers
 #include "ballistics/bullet.h"
+#include "ballistics/performance_matrix.h"
+#include "ballistics/range_table.h"
 #include "ballistics/simulator.h"
 #include "ballistics/trajectory.h"
+#include "ballistics/trajectory_observer.h"
 #include "match/match.h"
 #include "match/simulator.h"
 #include "match/target.h"
@@ -14,8 +17,11 @@
 #include "math/vector.h"
 #include "physics/atmosphere.h"
 #include "physics/wind_generator.h"
+#include "profiling/profiler.h"
 #include "rendering/impact_detector.h"
 #include "rendering/steel_target.h"
+#include "rendering/steel_target_world.h"
+#include "rendering/steel_texture_atlas.h"
 // wind_flag.h removed - flag animation moved to GPU shader
 
 using namespace emscripten;
@@ -25,7 +31,13 @@ using namespace btk::rendering;
 using namespace btk::math;
 using namespace btk::physics;
 
-// No wrapper needed - direct methods are JavaScript-friendly
+// Lets JS implement TrajectoryObserver: TrajectoryObserver.extend("TrajectoryObserver", { onPoint(point) { ... } })
+struct TrajectoryObserverWrapper : public wrapper<TrajectoryObserver>
+{
+  EMSCRIPTEN_WRAPPER(TrajectoryObserverWrapper);
+
+  bool onPoint(const TrajectoryPoint& point) override { return call<bool>("onPoint", point); }
+};
 
 EMSCRIPTEN_BINDINGS(ballistics_toolkit)
 {
@@ -174,16 +186,97 @@ EMSCRIPTEN_BINDINGS(ballistics_toolkit)
     .function("getPointCount", &Trajectory::getPointCount)
     .function("atDistance", &Trajectory::atDistance)
     .function("atTime", &Trajectory::atTime)
+    .function("sampleAtDistances", select_overload<emscripten::val(emscripten::val) const>(&Trajectory::sampleAtDistances))
+    .function("sampleAtTimes", select_overload<emscripten::val(emscripten::val) const>(&Trajectory::sampleAtTimes))
     .function("getTotalDistance", &Trajectory::getTotalDistance)
     .function("getTotalTime", &Trajectory::getTotalTime)
     .function("getMaximumHeight", &Trajectory::getMaximumHeight)
     .function("getImpactVelocity", &Trajectory::getImpactVelocity)
     .function("getImpactAngle", &Trajectory::getImpactAngle)
-    .function("clear", &Trajectory::clear);
+    .function("clear", &Trajectory::clear)
+    .class_property("SAMPLE_TIME", &Trajectory::SAMPLE_TIME)
+    .class_property("SAMPLE_X", &Trajectory::SAMPLE_X)
+    .class_property("SAMPLE_Y", &Trajectory::SAMPLE_Y)
+    .class_property("SAMPLE_Z", &Trajectory::SAMPLE_Z)
+    .class_property("SAMPLE_VX", &Trajectory::SAMPLE_VX)
+    .class_property("SAMPLE_VY", &Trajectory::SAMPLE_VY)
+    .class_property("SAMPLE_VZ", &Trajectory::SAMPLE_VZ)
+    .class_property("SAMPLE_VELOCITY", &Trajectory::SAMPLE_VELOCITY)
+    .class_property("SAMPLE_ENERGY", &Trajectory::SAMPLE_ENERGY)
+    .class_property("SAMPLE_STRIDE", &Trajectory::SAMPLE_STRIDE);
 
   // Register optional bindings used by trajectories and intersection helpers
   register_optional<btk::ballistics::TrajectoryPoint>();
 
+  // Streaming trajectory observers
+  class_<btk::ballistics::TrajectoryObserver>("TrajectoryObserver")
+    .function("onPoint", &TrajectoryObserver::onPoint, pure_virtual())
+    .allow_subclass<TrajectoryObserverWrapper>("TrajectoryObserverWrapper");
+
+  enum_<StationRecorder::StationType>("StationType").value("DISTANCE", StationRecorder::DISTANCE).value("TIME", StationRecorder::TIME);
+
+  class_<btk::ballistics::StationRecorder, base<btk::ballistics::TrajectoryObserver>>("StationRecorder")
+    .constructor<StationRecorder::StationType>()
+    .function("addStation", &StationRecorder::addStation)
+    .function("reset", &StationRecorder::reset)
+    .function("getPoints", &StationRecorder::getPoints)
+    .function("getSamples", select_overload<emscripten::val() const>(&StationRecorder::getSamples))
+    .function("isComplete", &StationRecorder::isComplete);
+
+  // Range table (dope card) for a zeroed rifle
+  enum_<RangeTable::AngleUnit>("RangeTableAngleUnit").value("MRAD", RangeTable::MRAD).value("MOA", RangeTable::MOA);
+
+  value_object<RangeTable::Row>("RangeTableRow")
+    .field("range", &RangeTable::Row::range_)
+    .field("drop", &RangeTable::Row::drop_)
+    .field("dropAngle", &RangeTable::Row::drop_angle_)
+    .field("windage", &RangeTable::Row::windage_)
+    .field("windageAngle", &RangeTable::Row::windage_angle_)
+    .field("windagePerMph", &RangeTable::Row::windage_per_mph_)
+    .field("spinDrift", &RangeTable::Row::spin_drift_)
+    .field("jumpPerMph", &RangeTable::Row::jump_per_mph_)
+    .field("time", &RangeTable::Row::time_)
+    .field("velocity", &RangeTable::Row::velocity_)
+    .field("energy", &RangeTable::Row::energy_);
+
+  class_<RangeTable>("RangeTable")
+    .constructor<const Bullet&, float, float, float, const Atmosphere&, const Vector3D&, float, RangeTable::AngleUnit, float>()
+    .function("build", select_overload<void(float, float)>(&RangeTable::build))
+    .function("buildAt", select_overload<void(emscripten::val)>(&RangeTable::buildAt))
+    .function("setExtendedColumns", &RangeTable::setExtendedColumns)
+    .function("getExtendedColumns", &RangeTable::getExtendedColumns)
+    .function("getRowCount", &RangeTable::getRowCount)
+    .function("getRow", &RangeTable::getRow)
+    .function("getData", &RangeTable::getData)
+    .function("getZeroedBullet", &RangeTable::getZeroedBullet)
+    .function("getAngleUnit", &RangeTable::getAngleUnit)
+    .class_property("FIELD_RANGE", &RangeTable::FIELD_RANGE)
+    .class_property("FIELD_DROP", &RangeTable::FIELD_DROP)
+    .class_property("FIELD_DROP_ANGLE", &RangeTable::FIELD_DROP_ANGLE)
+    .class_property("FIELD_WINDAGE", &RangeTable::FIELD_WINDAGE)
+    .class_property("FIELD_WINDAGE_ANGLE", &RangeTable::FIELD_WINDAGE_ANGLE)
+    .class_property("FIELD_WINDAGE_PER_MPH", &RangeTable::FIELD_WINDAGE_PER_MPH)
+    .class_property("FIELD_SPIN_DRIFT", &RangeTable::FIELD_SPIN_DRIFT)
+    .class_property("FIELD_JUMP_PER_MPH", &RangeTable::FIELD_JUMP_PER_MPH)
+    .class_property("FIELD_TIME", &RangeTable::FIELD_TIME)
+    .class_property("FIELD_VELOCITY", &RangeTable::FIELD_VELOCITY)
+    .class_property("FIELD_ENERGY", &RangeTable::FIELD_ENERGY)
+    .class_property("STRIDE", &RangeTable::STRIDE)
+    .class_property("REFERENCE_CROSSWIND_MPH", &RangeTable::REFERENCE_CROSSWIND_MPH);
+
+  // BC x MV comparison grids
+  class_<PerformanceMatrix>("PerformanceMatrix")
+    .constructor<const Bullet&, const Atmosphere&, float, float, float>()
+    .function("compute", &PerformanceMatrix::computeGrid)
+    .function("getBcCount", &PerformanceMatrix::getBcCount)
+    .function("getMvCount", &PerformanceMatrix::getMvCount)
+    .function("getDrift", &PerformanceMatrix::getDrift)
+    .function("getDrop", &PerformanceMatrix::getDrop)
+    .function("getSensitivity", &PerformanceMatrix::getSensitivity)
+    .function("getVelocity", &PerformanceMatrix::getVelocity)
+    .function("getEnergy", &PerformanceMatrix::getEnergy)
+    .class_property("MV_SPREAD", &PerformanceMatrix::MV_SPREAD);
+
   // Ballistics Simulator class
   class_<btk::ballistics::Simulator>("BallisticsSimulator")
     .constructor<>()
@@ -198,6 +291,9 @@ EMSCRIPTEN_BINDINGS(ballistics_toolkit)
     .function("computeZero", &btk::ballistics::Simulator::computeZero)
     .function("simulate", select_overload<void(float, float, float)>(&btk::ballistics::Simulator::simulate))
     .function("simulateWithWind", select_overload<void(float, float, float, const WindGenerator&)>(&btk::ballistics::Simulator::simulate))
+    .function("simulateWithWindLod", select_overload<void(float, float, float, const WindLodSampler&)>(&btk::ballistics::Simulator::simulate))
+    .function("simulateObserved", select_overload<void(float, float, float, TrajectoryObserver&)>(&btk::ballistics::Simulator::simulate))
+    .function("simulateWithWindObserved", select_overload<void(float, float, float, const WindGenerator&, TrajectoryObserver&)>(&btk::ballistics::Simulator::simulate))
     .function("getTrajectory", select_overload<Trajectory&()>(&btk::ballistics::Simulator::getTrajectory), return_value_policy::reference())
     .function("timeStep", &btk::ballistics::Simulator::timeStep);
 
@@ -272,6 +368,7 @@ EMSCRIPTEN_BINDINGS(ballistics_toolkit)
 
   // Register value arrays for easier JavaScript usage
   register_vector<TrajectoryPoint>("TrajectoryPointVector");
+  register_vector<Trajectory>("TrajectoryVector");
   register_vector<Hit>("HitVector");
   register_vector<SimulatedShot>("SimulatedShotVector");
   register_vector<std::string>("StringVector");
@@ -280,6 +377,11 @@ EMSCRIPTEN_BINDINGS(ballistics_toolkit)
   // No RingInfo struct needed - direct methods are cleaner
 
   // Wind generator class
+  enum_<WindShearProfile>("WindShearProfile")
+    .value("UNIFORM", WindShearProfile::UNIFORM)
+    .value("LOGARITHMIC", WindShearProfile::LOGARITHMIC)
+    .value("POWER_LAW", WindShearProfile::POWER_LAW);
+
   class_<btk::physics::WindGenerator>("WindGenerator")
     .constructor<>()
     .function("advanceTime", &WindGenerator::advanceTime)
@@ -298,7 +400,24 @@ EMSCRIPTEN_BINDINGS(ballistics_toolkit)
     .function("getComponentRMS", &WindGenerator::getComponentRMS)
     .function("getGlobalAdvectionOffset", &WindGenerator::getGlobalAdvectionOffset)
     .function("getGlobalAdvectionVelocity", &WindGenerator::getGlobalAdvectionVelocity)
-    .function("getCurrentTime", &WindGenerator::getCurrentTime);
+    .function("getCurrentTime", &WindGenerator::getCurrentTime)
+    .function("setShearProfile", &WindGenerator::setShearProfile)
+    .function("getShearProfile", &WindGenerator::getShearProfile)
+    .function("getShearFactor", &WindGenerator::getShearFactor)
+    .function("setMuzzleHeight", &WindGenerator::setMuzzleHeight)
+    .function("getMuzzleHeight", &WindGenerator::getMuzzleHeight)
+    .function("updateFieldTexture", &WindGenerator::updateFieldTexture)
+    .function("getFieldTexture", &WindGenerator::getFieldTexture)
+    .function("getFieldTextureWidth", &WindGenerator::getFieldTextureWidth)
+    .function("getFieldTextureHeight", &WindGenerator::getFieldTextureHeight);
+
+  // Level-of-detail wind sampler (holds a reference to the generator)
+  class_<btk::physics::WindLodSampler>("WindLodSampler")
+    .constructor<const WindGenerator&, const Vector3D&, const Vector3D&, float, float>()
+    .function("sample", select_overload<Vector3D(float, float, float) const>(&WindLodSampler::operator()))
+    .function("refresh", &WindLodSampler::refresh)
+    .function("getNumFrozenComponents", &WindLodSampler::getNumFrozenComponents)
+    .function("getNumLiveComponents", &WindLodSampler::getNumLiveComponents);
 
   // Wind presets factory
   class_<btk::physics::WindPresets>("WindPresets")
@@ -324,6 +443,16 @@ EMSCRIPTEN_BINDINGS(ballistics_toolkit)
     .field("normalWorld", &btk::rendering::SteelTarget::RaycastHit::normal_world_)
     .field("distanceM", &btk::rendering::SteelTarget::RaycastHit::distance_m_);
 
+  value_object<btk::rendering::SteelTarget::DirtyRect>("SteelTargetDirtyRect")
+    .field("x", &btk::rendering::SteelTarget::DirtyRect::x_)
+    .field("y", &btk::rendering::SteelTarget::DirtyRect::y_)
+    .field("width", &btk::rendering::SteelTarget::DirtyRect::width_)
+    .field("height", &btk::rendering::SteelTarget::DirtyRect::height_);
+
+  enum_<btk::rendering::SteelTarget::ChainSolver>("SteelChainSolver")
+    .value("SPRING", btk::rendering::SteelTarget::SPRING)
+    .value("IMPLICIT", btk::rendering::SteelTarget::IMPLICIT);
+
   // Register optional<RaycastHit> and vectors for SteelTarget
   register_optional<btk::rendering::SteelTarget::RaycastHit>();
   register_vector<btk::rendering::SteelTarget::ChainAnchor>("ChainAnchorVector");
@@ -338,6 +467,8 @@ EMSCRIPTEN_BINDINGS(ballistics_toolkit)
     .function("intersectSegment", &btk::rendering::SteelTarget::intersectSegment)
     .function("intersectTrajectory", &btk::rendering::SteelTarget::intersectTrajectory)
     .function("timeStep", &btk::rendering::SteelTarget::timeStep)
+    .function("setChainSolver", &btk::rendering::SteelTarget::setChainSolver)
+    .function("getChainSolver", &btk::rendering::SteelTarget::getChainSolver)
     .function("getImpacts", &btk::rendering::SteelTarget::getImpacts)
     .function("getAnchors", &btk::rendering::SteelTarget::getAnchorsRef, return_value_policy::reference())
     .function("getCenterOfMass", &btk::rendering::SteelTarget::getCenterOfMass)
@@ -354,10 +485,69 @@ EMSCRIPTEN_BINDINGS(ballistics_toolkit)
     .function("initializeTexture", &btk::rendering::SteelTarget::initializeTexture)
     .function("getTextureWidth", &btk::rendering::SteelTarget::getTextureWidth)
     .function("getTextureHeight", &btk::rendering::SteelTarget::getTextureHeight)
+    .function("setTextureSize", &btk::rendering::SteelTarget::setTextureSize)
+    .class_function("textureSizeFor", &btk::rendering::SteelTarget::textureSizeFor)
+    .function("setMipmapsEnabled", &btk::rendering::SteelTarget::setMipmapsEnabled)
+    .function("isMipmapsEnabled", &btk::rendering::SteelTarget::isMipmapsEnabled)
+    .function("getMipLevelCount", &btk::rendering::SteelTarget::getMipLevelCount)
+    .function("getMipLevelWidth", &btk::rendering::SteelTarget::getMipLevelWidth)
+    .function("getMipLevelHeight", &btk::rendering::SteelTarget::getMipLevelHeight)
+    .function("getMipLevel", &btk::rendering::SteelTarget::getMipLevel)
     .function("getTexture", &btk::rendering::SteelTarget::getTexture)
+    .function("hasDirtyRect", &btk::rendering::SteelTarget::hasDirtyRect)
+    .function("getDirtyRect", &btk::rendering::SteelTarget::getDirtyRect)
+    .function("getDirtyTextureRows", &btk::rendering::SteelTarget::getDirtyTextureRows)
+    .function("clearDirtyRect", &btk::rendering::SteelTarget::clearDirtyRect)
+    .function("setTextureEnabled", &btk::rendering::SteelTarget::setTextureEnabled)
+    .function("isTextureEnabled", &btk::rendering::SteelTarget::isTextureEnabled)
+    .function("getDecals", &btk::rendering::SteelTarget::getDecals)
+    .function("getDecalCount", &btk::rendering::SteelTarget::getDecalCount)
+    .class_function("decalRandom", &btk::rendering::SteelTarget::decalRandom)
+    .class_property("DECAL_STRIDE", &btk::rendering::SteelTarget::DECAL_STRIDE)
     .function("setColors", &btk::rendering::SteelTarget::setColors)
     .function("localToWorld", &btk::rendering::SteelTarget::localToWorld);
 
+  // Batch physics stepping for all steel targets
+  class_<btk::rendering::SteelTargetWorld>("SteelTargetWorld")
+    .constructor<>()
+    .function("addTarget", &btk::rendering::SteelTargetWorld::addTarget, allow_raw_pointers())
+    .function("removeTarget", &btk::rendering::SteelTargetWorld::removeTarget)
+    .function("clear", &btk::rendering::SteelTargetWorld::clear)
+    .function("wake", &btk::rendering::SteelTargetWorld::wake)
+    .function("hit", &btk::rendering::SteelTargetWorld::hit)
+    .function("step", &btk::rendering::SteelTargetWorld::step)
+    .function("getTargetCount", &btk::rendering::SteelTargetWorld::getTargetCount)
+    .function("getAwakeCount", &btk::rendering::SteelTargetWorld::getAwakeCount)
+    .function("getAwakeIndices", &btk::rendering::SteelTargetWorld::getAwakeIndices);
+
+  // Shared paint texture pages for many steel targets
+  value_object<btk::rendering::SteelTextureAtlas::Region>("SteelTextureRegion")
+    .field("page", &btk::rendering::SteelTextureAtlas::Region::page_)
+    .field("x", &btk::rendering::SteelTextureAtlas::Region::x_)
+    .field("y", &btk::rendering::SteelTextureAtlas::Region::y_)
+    .field("width", &btk::rendering::SteelTextureAtlas::Region::width_)
+    .field("height", &btk::rendering::SteelTextureAtlas::Region::height_);
+
+  value_object<btk::rendering::SteelTextureAtlas::UVRect>("SteelTextureUVRect")
+    .field("u", &btk::rendering::SteelTextureAtlas::UVRect::u_)
+    .field("v", &btk::rendering::SteelTextureAtlas::UVRect::v_)
+    .field("width", &btk::rendering::SteelTextureAtlas::UVRect::width_)
+    .field("height", &btk::rendering::SteelTextureAtlas::UVRect::height_);
+
+  class_<btk::rendering::SteelTextureAtlas>("SteelTextureAtlas")
+    .constructor<>()
+    .constructor<int>()
+    .function("addTarget", &btk::rendering::SteelTextureAtlas::addTarget, allow_raw_pointers())
+    .function("removeTarget", &btk::rendering::SteelTextureAtlas::removeTarget)
+    .function("clear", &btk::rendering::SteelTextureAtlas::clear)
+    .function("getRegion", &btk::rendering::SteelTextureAtlas::getRegion)
+    .function("getUVRect", &btk::rendering::SteelTextureAtlas::getUVRect)
+    .function("getTargetCount", &btk::rendering::SteelTextureAtlas::getTargetCount)
+    .function("getPageCount", &btk::rendering::SteelTextureAtlas::getPageCount)
+    .function("getPageSize", &btk::rendering::SteelTextureAtlas::getPageSize)
+    .function("getTexels", &btk::rendering::SteelTextureAtlas::getTexels)
+    .function("getPageRows", &btk::rendering::SteelTextureAtlas::getPageRows);
+
   // WindFlag removed - animation moved to GPU shader in WindFlag.js
 
   // Impact detection
@@ -372,12 +562,38 @@ EMSCRIPTEN_BINDINGS(ballistics_toolkit)
 
   class_<btk::rendering::ImpactDetector>("ImpactDetector")
     .constructor<float, float, float, float, float>()
-    .function("addMeshCollider", &btk::rendering::ImpactDetector::addMeshCollider)
+    .function("addMeshCollider", select_overload<int(emscripten::val, emscripten::val, int)>(&btk::rendering::ImpactDetector::addMeshCollider))
     .function("addSteelCollider", &btk::rendering::ImpactDetector::addSteelCollider, allow_raw_pointer<arg<0>>())
     .function("moveCollider", &btk::rendering::ImpactDetector::moveCollider)
     .function("removeCollider", &btk::rendering::ImpactDetector::removeCollider)
-    .function("findFirstImpact", &btk::rendering::ImpactDetector::findFirstImpact)
+    .function("setColliderVelocity", &btk::rendering::ImpactDetector::setColliderVelocity)
+    .function("findFirstImpact", select_overload<std::optional<btk::rendering::ImpactResult>(const btk::ballistics::Trajectory&, float, float) const>(&btk::rendering::ImpactDetector::findFirstImpact))
+    .function("findFirstImpact",
+              select_overload<std::optional<btk::rendering::ImpactResult>(const btk::ballistics::Trajectory&, float, float, float) const>(&btk::rendering::ImpactDetector::findFirstImpact))
+    .function("findFirstImpactBatch", &btk::rendering::ImpactDetector::findFirstImpactBatch)
     .function("setColliderEnabled", &btk::rendering::ImpactDetector::setColliderEnabled)
     .function("isColliderEnabled", &btk::rendering::ImpactDetector::isColliderEnabled)
-    .function("getNextHandle", &btk::rendering::ImpactDetector::getNextHandle);
-}
\ No newline at end of file
+    .function("getColliderCount", &btk::rendering::ImpactDetector::getColliderCount);
+
+  // Hot-path counters and timers (all zero unless built with BTK_PROFILING)
+  value_object<btk::profiling::Profiler::FrameSnapshot>("ProfilerFrameSnapshot")
+    .field("frame", &btk::profiling::Profiler::FrameSnapshot::frame_)
+    .field("trajectorySteps", &btk::profiling::Profiler::FrameSnapshot::trajectory_steps_)
+    .field("windSamples", &btk::profiling::Profiler::FrameSnapshot::wind_samples_)
+    .field("noiseEvaluations", &btk::profiling::Profiler::FrameSnapshot::noise_evaluations_)
+    .field("broadphaseCells", &btk::profiling::Profiler::FrameSnapshot::broadphase_cells_)
+    .field("triangleTests", &btk::profiling::Profiler::FrameSnapshot::triangle_tests_)
+    .field("steelSubsteps", &btk::profiling::Profiler::FrameSnapshot::steel_substeps_)
+    .field("texturePixels", &btk::profiling::Profiler::FrameSnapshot::texture_pixels_)
+    .field("trajectoryMs", &btk::profiling::Profiler::FrameSnapshot::trajectory_ms_)
+    .field("windMs", &btk::profiling::Profiler::FrameSnapshot::wind_ms_)
+    .field("impactDetectionMs", &btk::profiling::Profiler::FrameSnapshot::impact_detection_ms_)
+    .field("steelPhysicsMs", &btk::profiling::Profiler::FrameSnapshot::steel_physics_ms_)
+    .field("texturePaintMs", &btk::profiling::Profiler::FrameSnapshot::texture_paint_ms_);
+
+  class_<btk::profiling::Profiler>("Profiler")
+    .class_function("isEnabled", &btk::profiling::Profiler::isEnabled)
+    .class_function("endFrame", &btk::profiling::Profiler::endFrame)
+    .class_function("getFrameSnapshot", &btk::profiling::Profiler::getFrameSnapshot)
+    .class_function("reset", &btk::profiling::Profiler::reset);
+}
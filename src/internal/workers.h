@@ -0,0 +1,57 @@
+#pragma once
+
+// Worker threads shared by the batch engines (ImpactDetector, PerformanceMatrix).
+// Internal to the library: lives under src/ and is not installed.
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Threads run natively and in pthread WebAssembly builds; other WebAssembly builds run on the calling thread
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#include <thread>
+#define BTK_THREADS 1
+#endif
+
+namespace btk::internal
+{
+
+  // Worker count for a batch of item_count items (<= 0 requests one per hardware thread)
+  inline int resolveThreadCount(int thread_count, size_t item_count)
+  {
+#ifdef BTK_THREADS
+    if(thread_count <= 0)
+    {
+      thread_count = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+#else
+    thread_count = 1;
+#endif
+    return static_cast<int>(std::max<size_t>(1, std::min(static_cast<size_t>(thread_count), item_count)));
+  }
+
+  // Run work(worker) for worker in [0, worker_count); worker 0 runs on the calling thread
+  template <typename Work>
+  void runWorkers(int worker_count, Work&& work)
+  {
+#ifdef BTK_THREADS
+    std::vector<std::thread> threads;
+    threads.reserve(worker_count - 1);
+    for(int worker = 1; worker < worker_count; ++worker)
+    {
+      threads.emplace_back([&work, worker]() { work(worker); });
+    }
+    work(0);
+    for(std::thread& thread : threads)
+    {
+      thread.join();
+    }
+#else
+    for(int worker = 0; worker < worker_count; ++worker)
+    {
+      work(worker);
+    }
+#endif
+  }
+
+} // namespace btk::internal
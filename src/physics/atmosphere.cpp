@@ -1,6 +1,7 @@
 #include "physics/atmosphere.h"
 #include "physics/constants.h"
 #include <cmath>
+#include <stdexcept>
 
 namespace btk
 {
@@ -2,6 +2,8 @@
 #include "math/conversions.h"
 #include "math/random.h"
 #include "physics/constants.h"
+#include "profiling/profiler.h"
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 
@@ -77,6 +79,67 @@ namespace btk::physics
     sample_corners_[1] = max_corner;
   }
 
+  void WindGenerator::setShearProfile(WindShearProfile profile, float reference_height_m, float roughness_length_m, float power_law_exponent)
+  {
+    shear_profile_ = profile;
+    shear_table_.clear();
+    if(profile == UNIFORM)
+    {
+      return;
+    }
+
+    if(reference_height_m <= 0.0f)
+    {
+      throw std::invalid_argument("Shear reference height must be positive");
+    }
+    if(profile == LOGARITHMIC && (roughness_length_m <= 0.0f || roughness_length_m >= reference_height_m))
+    {
+      throw std::invalid_argument("Roughness length must be positive and below the reference height");
+    }
+
+    shear_table_.resize(SHEAR_TABLE_SIZE);
+    const float step = SHEAR_TABLE_MAX_HEIGHT / static_cast<float>(SHEAR_TABLE_SIZE - 1);
+    const float log_reference = std::log(reference_height_m / roughness_length_m);
+    for(int i = 0; i < SHEAR_TABLE_SIZE; ++i)
+    {
+      const float height = static_cast<float>(i) * step;
+      float factor;
+      if(profile == LOGARITHMIC)
+      {
+        // Log law is zero at and below the roughness length
+        factor = height > roughness_length_m ? std::log(height / roughness_length_m) / log_reference : 0.0f;
+      }
+      else
+      {
+        factor = std::pow(height / reference_height_m, power_law_exponent);
+      }
+      shear_table_[i] = factor;
+    }
+  }
+
+  float WindGenerator::getShearFactor(float height_m) const
+  {
+    if(shear_table_.empty())
+    {
+      return 1.0f;
+    }
+
+    // Linear interpolation in the precomputed table, clamped at both ends
+    const float position = std::clamp(height_m, 0.0f, SHEAR_TABLE_MAX_HEIGHT) * (static_cast<float>(SHEAR_TABLE_SIZE - 1) / SHEAR_TABLE_MAX_HEIGHT);
+    const int index = std::min(static_cast<int>(position), SHEAR_TABLE_SIZE - 2);
+    const float frac = position - static_cast<float>(index);
+    return shear_table_[index] + (shear_table_[index + 1] - shear_table_[index]) * frac;
+  }
+
+  void WindGenerator::setMuzzleHeight(float muzzle_height_m)
+  {
+    if(!(muzzle_height_m >= 0.0f))
+    {
+      throw std::invalid_argument("Muzzle height must not be negative");
+    }
+    muzzle_height_m_ = muzzle_height_m;
+  }
+
   void WindGenerator::setAdvectionGain(float gain) { advection_gain_ = std::max(0.0f, gain); }
 
   float WindGenerator::getAdvectionGain() const { return advection_gain_; }
@@ -181,11 +244,20 @@ namespace btk::physics
     // Scale time by temporal scale (use explicit time parameter)
     float scaled_time = time / component.temporal_scale;
 
-    // Central differences in scaled space for better accuracy
-    float psi_x_plus = component.noise.noise3D(scaled_x + epsilon, scaled_y, scaled_time);
-    float psi_x_minus = component.noise.noise3D(scaled_x - epsilon, scaled_y, scaled_time);
-    float psi_y_plus = component.noise.noise3D(scaled_x, scaled_y + epsilon, scaled_time);
-    float psi_y_minus = component.noise.noise3D(scaled_x, scaled_y - epsilon, scaled_time);
+    // Central differences in scaled space for better accuracy; the four stencil
+    // points (x+, x-, y+, y-) are evaluated together on SIMD lanes
+    using btk::math::simd::vfloat4;
+    using btk::math::simd::vint4;
+    vfloat4 stencil_x = {scaled_x + epsilon, scaled_x - epsilon, scaled_x, scaled_x};
+    vfloat4 stencil_y = {scaled_y, scaled_y, scaled_y + epsilon, scaled_y - epsilon};
+    vfloat4 stencil_t = {scaled_time, scaled_time, scaled_time, scaled_time};
+    BTK_PROFILE_COUNT(NOISE_EVALUATIONS, 4);
+    vfloat4 psi = component.noise.noise3DLanes<vfloat4, vint4>(stencil_x, stencil_y, stencil_t);
+
+    float psi_x_plus = psi[0];
+    float psi_x_minus = psi[1];
+    float psi_y_plus = psi[2];
+    float psi_y_minus = psi[3];
 
     float dpsi_dscaled_x = (psi_x_plus - psi_x_minus) / (2.0f * epsilon);
     float dpsi_dscaled_y = (psi_y_plus - psi_y_minus) / (2.0f * epsilon);
@@ -294,13 +366,16 @@ namespace btk::physics
 
   btk::math::Vector3D WindGenerator::sample(const btk::math::Vector3D& pos) const
   {
+    BTK_PROFILE_SCOPE(WIND);
+    BTK_PROFILE_COUNT(WIND_SAMPLES, 1);
+
     // Allow sampling outside bounds - wind field is continuous
     btk::math::Vector3D velocity = btk::math::Vector3D(0.0f, 0.0f, 0.0f);
     for(size_t i = 0; i < components_.size(); i++)
     {
       velocity += sampleComponent(i, pos);
     }
-    return velocity;
+    return velocity * getShearFactor(pos.y + muzzle_height_m_);
   }
 
   btk::math::Vector3D WindGenerator::sample(float x_m, float y_m, float z_m) const { return sample(btk::math::Vector3D(x_m, y_m, z_m)); }
@@ -309,6 +384,167 @@ namespace btk::physics
 
   btk::math::Vector3D WindGenerator::operator()(const btk::math::Vector3D& pos) const { return sample(pos); }
 
+  void WindGenerator::rasterize(float* out, int width, int height, const btk::math::Vector3D& min_corner, const btk::math::Vector3D& max_corner) const
+  {
+    if(width <= 0 || height <= 0)
+    {
+      return;
+    }
+
+    // Components much larger than the rectangle are evaluated once, not per texel
+    WindLodSampler sampler(*this, min_corner, max_corner);
+
+    const float step_x = (max_corner.x - min_corner.x) / static_cast<float>(width);
+    const float step_z = (max_corner.z - min_corner.z) / static_cast<float>(height);
+
+    for(int row = 0; row < height; ++row)
+    {
+      const float z = min_corner.z + (static_cast<float>(row) + 0.5f) * step_z;
+      float* texel = out + static_cast<size_t>(row) * width * 2;
+      for(int col = 0; col < width; ++col)
+      {
+        const float x = min_corner.x + (static_cast<float>(col) + 0.5f) * step_x;
+        btk::math::Vector3D wind = sampler(x, min_corner.y, z);
+        texel[0] = wind.x;
+        texel[1] = wind.z;
+        texel += 2;
+      }
+    }
+  }
+
+  void WindGenerator::updateFieldTexture(int width, int height, const btk::math::Vector3D& min_corner, const btk::math::Vector3D& max_corner)
+  {
+    if(width <= 0 || height <= 0)
+    {
+      throw std::invalid_argument("Field texture dimensions must be positive");
+    }
+
+    if(width != field_texture_width_ || height != field_texture_height_)
+    {
+      field_texture_width_ = width;
+      field_texture_height_ = height;
+      field_texture_.assign(static_cast<size_t>(width) * height * 2, 0.0f);
+    }
+
+    rasterize(field_texture_.data(), width, height, min_corner, max_corner);
+  }
+
+#ifdef __EMSCRIPTEN__
+  emscripten::val WindGenerator::getFieldTexture() const
+  {
+    using namespace emscripten;
+    if(field_texture_.empty())
+    {
+      return val::global("Float32Array").new_(0);
+    }
+    return val(typed_memory_view(field_texture_.size(), field_texture_.data()));
+  }
+#endif
+
+  // ----------- WindLodSampler -------------------------------------------------
+
+  WindLodSampler::WindLodSampler(const WindGenerator& wind, const btk::math::Vector3D& min_corner, const btk::math::Vector3D& max_corner, float time_horizon_s, float lod_threshold)
+    : wind_(&wind), min_corner_(min_corner), max_corner_(max_corner), time_horizon_s_(std::max(0.0f, time_horizon_s)), lod_threshold_(std::max(0.0f, lod_threshold))
+  {
+    build();
+  }
+
+  void WindLodSampler::build()
+  {
+    const int num_components = wind_->getNumActiveComponents();
+    built_time_ = wind_->getCurrentTime();
+    center_ = (min_corner_ + max_corner_) * 0.5f;
+
+    // Region span in generator axes: X=crossrange, Z=-downrange (height is not part of the field)
+    const float crossrange_span = std::fabs(max_corner_.x - min_corner_.x);
+    const float downrange_span = std::fabs(max_corner_.z - min_corner_.z);
+
+    frozen_.assign(num_components, false);
+    live_components_.clear();
+    num_frozen_ = 0;
+
+    for(int i = 0; i < num_components; ++i)
+    {
+      // Relative variation of the component across the region and horizon
+      float variation = downrange_span / wind_->getComponentDownrangeScale(i) + crossrange_span / wind_->getComponentCrossrangeScale(i) + time_horizon_s_ / wind_->getComponentTemporalScale(i);
+
+      if(variation <= lod_threshold_)
+      {
+        frozen_[i] = true;
+        ++num_frozen_;
+      }
+      else
+      {
+        live_components_.push_back(i);
+      }
+    }
+
+    frozen_value_ = btk::math::Vector3D(0.0f, 0.0f, 0.0f);
+    frozen_grad_x_ = btk::math::Vector3D(0.0f, 0.0f, 0.0f);
+    frozen_grad_z_ = btk::math::Vector3D(0.0f, 0.0f, 0.0f);
+    if(num_frozen_ == 0)
+    {
+      return;
+    }
+
+    frozen_value_ = sampleFrozen(center_);
+
+    // Central differences across the region half-extent for linear extrapolation
+    const float half_x = 0.5f * crossrange_span;
+    const float half_z = 0.5f * downrange_span;
+    if(half_x > 0.0f)
+    {
+      btk::math::Vector3D dx(half_x, 0.0f, 0.0f);
+      frozen_grad_x_ = (sampleFrozen(center_ + dx) - sampleFrozen(center_ - dx)) / (2.0f * half_x);
+    }
+    if(half_z > 0.0f)
+    {
+      btk::math::Vector3D dz(0.0f, 0.0f, half_z);
+      frozen_grad_z_ = (sampleFrozen(center_ + dz) - sampleFrozen(center_ - dz)) / (2.0f * half_z);
+    }
+  }
+
+  btk::math::Vector3D WindLodSampler::sampleFrozen(const btk::math::Vector3D& pos) const
+  {
+    btk::math::Vector3D velocity(0.0f, 0.0f, 0.0f);
+    for(size_t i = 0; i < frozen_.size(); ++i)
+    {
+      if(frozen_[i])
+      {
+        velocity += wind_->sampleComponent(static_cast<int>(i), pos);
+      }
+    }
+    return velocity;
+  }
+
+  bool WindLodSampler::refresh()
+  {
+    // Component set changed or frozen values went stale
+    bool stale = wind_->getNumActiveComponents() != static_cast<int>(frozen_.size()) || wind_->getCurrentTime() - built_time_ > time_horizon_s_;
+    if(!stale)
+    {
+      return false;
+    }
+
+    build();
+    return true;
+  }
+
+  btk::math::Vector3D WindLodSampler::sample(const btk::math::Vector3D& pos) const
+  {
+    BTK_PROFILE_SCOPE(WIND);
+    BTK_PROFILE_COUNT(WIND_SAMPLES, 1);
+
+    btk::math::Vector3D velocity = frozen_value_ + frozen_grad_x_ * (pos.x - center_.x) + frozen_grad_z_ * (pos.z - center_.z);
+    for(int i : live_components_)
+    {
+      velocity += wind_->sampleComponent(i, pos);
+    }
+    return velocity * wind_->getShearFactor(pos.y + wind_->getMuzzleHeight());
+  }
+
+  btk::math::Vector3D WindLodSampler::operator()(float x_m, float y_m, float z_m) const { return sample(btk::math::Vector3D(x_m, y_m, z_m)); }
+
   // ----------- WindPresets ----------------------------------------------------
 
   std::map<std::string, std::function<WindGenerator()>> WindPresets::presets_;
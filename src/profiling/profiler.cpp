@@ -0,0 +1,54 @@
+#include "profiling/profiler.h"
+
+namespace btk::profiling
+{
+
+  Profiler Profiler::instance_;
+
+  Profiler::FrameSnapshot Profiler::endFrame()
+  {
+    Profiler& p = instance_;
+    uint64_t counts[COUNTER_COUNT];
+    uint64_t times_ns[TIMER_COUNT];
+    for(int i = 0; i < COUNTER_COUNT; ++i)
+    {
+      counts[i] = p.counters_[i].exchange(0, std::memory_order_relaxed);
+    }
+    for(int i = 0; i < TIMER_COUNT; ++i)
+    {
+      times_ns[i] = p.timers_ns_[i].exchange(0, std::memory_order_relaxed);
+    }
+
+    FrameSnapshot& frame = p.last_frame_;
+    frame.frame_ = ++p.frame_count_;
+    frame.trajectory_steps_ = static_cast<double>(counts[TRAJECTORY_STEPS]);
+    frame.wind_samples_ = static_cast<double>(counts[WIND_SAMPLES]);
+    frame.noise_evaluations_ = static_cast<double>(counts[NOISE_EVALUATIONS]);
+    frame.broadphase_cells_ = static_cast<double>(counts[BROADPHASE_CELLS]);
+    frame.triangle_tests_ = static_cast<double>(counts[TRIANGLE_TESTS]);
+    frame.steel_substeps_ = static_cast<double>(counts[STEEL_SUBSTEPS]);
+    frame.texture_pixels_ = static_cast<double>(counts[TEXTURE_PIXELS]);
+    frame.trajectory_ms_ = times_ns[TRAJECTORY] * 1e-6;
+    frame.wind_ms_ = times_ns[WIND] * 1e-6;
+    frame.impact_detection_ms_ = times_ns[IMPACT_DETECTION] * 1e-6;
+    frame.steel_physics_ms_ = times_ns[STEEL_PHYSICS] * 1e-6;
+    frame.texture_paint_ms_ = times_ns[TEXTURE_PAINT] * 1e-6;
+    return frame;
+  }
+
+  void Profiler::reset()
+  {
+    Profiler& p = instance_;
+    for(auto& counter : p.counters_)
+    {
+      counter.store(0, std::memory_order_relaxed);
+    }
+    for(auto& timer : p.timers_ns_)
+    {
+      timer.store(0, std::memory_order_relaxed);
+    }
+    p.last_frame_ = FrameSnapshot();
+    p.frame_count_ = 0;
+  }
+
+} // namespace btk::profiling
@@ -1,4 +1,6 @@
 #include "rendering/impact_detector.h"
+#include "profiling/profiler.h"
+#include "internal/workers.h"
 
 #include <algorithm>
 #include <cmath>
@@ -8,6 +10,31 @@
 namespace btk::rendering
 {
 
+  namespace
+  {
+    using btk::internal::resolveThreadCount;
+    using btk::internal::runWorkers;
+
+    // floor() to int without a libm call (bin coordinates are well inside int range)
+    inline int floorToInt(float x)
+    {
+      int i = static_cast<int>(x);
+      return i - (x < static_cast<float>(i));
+    }
+
+    // Axis-aligned bounds of polyline points [0, segment_count]
+    inline void polylineBounds(const btk::math::Vector3D* positions, size_t segment_count, btk::math::Vector3D& min_bounds, btk::math::Vector3D& max_bounds)
+    {
+      min_bounds = positions[0];
+      max_bounds = positions[0];
+      for(size_t i = 1; i <= segment_count; ++i)
+      {
+        min_bounds = btk::math::Vector3D(std::min(min_bounds.x, positions[i].x), std::min(min_bounds.y, positions[i].y), std::min(min_bounds.z, positions[i].z));
+        max_bounds = btk::math::Vector3D(std::max(max_bounds.x, positions[i].x), std::max(max_bounds.y, positions[i].y), std::max(max_bounds.z, positions[i].z));
+      }
+    }
+  } // namespace
+
   // ===== Collider =====
 
   Collider::Collider(const std::vector<float>& vertices, const std::vector<uint32_t>& indices) : indices_(indices), position_(0, 0, 0), rotation_(0, 0, 0, 1)
@@ -38,6 +65,19 @@ namespace btk::rendering
       throw std::invalid_argument("Collider: index count must be multiple of 3");
     }
 
+    bvh_.build(vertices_, indices_);
+
+    // One SIMD block run per BVH leaf
+    std::vector<TriangleBlocks::Range> leaves;
+    for(const MeshBvh::Node& node : bvh_.getNodes())
+    {
+      if(node.count > 0)
+      {
+        leaves.push_back({node.offset, node.count});
+      }
+    }
+    triangle_blocks_.bake(vertices_, indices_, leaves);
+
     computeLocalBounds();
     updateWorldBounds();
   }
@@ -122,6 +162,114 @@ namespace btk::rendering
     updateWorldBounds();
   }
 
+  void Collider::setVelocity(const btk::math::Vector3D& linear_velocity, const btk::math::Vector3D& angular_velocity)
+  {
+    linear_velocity_ = linear_velocity;
+    angular_velocity_ = angular_velocity;
+  }
+
+  bool Collider::isMoving() const
+  {
+    if(steel_target_)
+    {
+      return steel_target_->isMoving();
+    }
+    return linear_velocity_.magnitude() > 0.0f || angular_velocity_.magnitude() > 0.0f;
+  }
+
+  void Collider::getMotion(btk::math::Vector3D& pivot, btk::math::Vector3D& linear_velocity, btk::math::Vector3D& angular_velocity) const
+  {
+    if(steel_target_)
+    {
+      pivot = steel_target_->getCenterOfMass();
+      linear_velocity = steel_target_->getVelocity();
+      angular_velocity = steel_target_->getAngularVelocity();
+    }
+    else
+    {
+      pivot = position_;
+      linear_velocity = linear_velocity_;
+      angular_velocity = angular_velocity_;
+    }
+  }
+
+  void Collider::sweptBounds(float max_dt_s, btk::math::Vector3D& min_bounds, btk::math::Vector3D& max_bounds) const
+  {
+    using btk::math::Vector3D;
+
+    Vector3D pivot, linear_velocity, angular_velocity;
+    getMotion(pivot, linear_velocity, angular_velocity);
+
+    // Farthest point of the bounds from the pivot limits how far rotation can carry geometry
+    Vector3D reach(std::max(std::fabs(min_bounds_m_.x - pivot.x), std::fabs(max_bounds_m_.x - pivot.x)), std::max(std::fabs(min_bounds_m_.y - pivot.y), std::fabs(max_bounds_m_.y - pivot.y)),
+                   std::max(std::fabs(min_bounds_m_.z - pivot.z), std::fabs(max_bounds_m_.z - pivot.z)));
+    const float margin = (linear_velocity.magnitude() + angular_velocity.magnitude() * reach.magnitude()) * max_dt_s;
+
+    min_bounds = Vector3D(min_bounds_m_.x - margin, min_bounds_m_.y - margin, min_bounds_m_.z - margin);
+    max_bounds = Vector3D(max_bounds_m_.x + margin, max_bounds_m_.y + margin, max_bounds_m_.z + margin);
+  }
+
+  std::optional<ImpactResult> Collider::intersectMovingSegment(const btk::math::Vector3D& start_m, const btk::math::Vector3D& end_m, float t_start_s, float t_end_s, float bullet_radius,
+                                                               float reference_time_s) const
+  {
+    using btk::math::Quaternion;
+    using btk::math::Vector3D;
+
+    Vector3D pivot, linear_velocity, angular_velocity;
+    getMotion(pivot, linear_velocity, angular_velocity);
+    const float angular_speed = angular_velocity.magnitude();
+    const Vector3D axis = angular_speed > 0.0f ? angular_velocity / angular_speed : Vector3D(0, 1, 0);
+
+    // Express a point at time reference + dt relative to the current pose: undo the pivot's
+    // travel and the rotation accumulated over dt
+    auto toCurrentPose = [&](const Vector3D& point, float dt_s)
+    {
+      Vector3D offset = point - (pivot + linear_velocity * dt_s);
+      if(angular_speed * std::fabs(dt_s) > 1e-8f)
+      {
+        offset = Quaternion::fromAxisAngle(axis, -angular_speed * dt_s).rotate(offset);
+      }
+      return pivot + offset;
+    };
+
+    // Linear motion maps the segment to a straight one; rotation bends it, so split the
+    // segment until each piece turns by at most MAX_PIECE_ANGLE
+    constexpr float MAX_PIECE_ANGLE = 0.002f; // radians
+    constexpr int MAX_PIECES = 64;
+    const float turn = angular_speed * std::fabs(t_end_s - t_start_s);
+    const int pieces = std::clamp(static_cast<int>(std::ceil(turn / MAX_PIECE_ANGLE)), 1, MAX_PIECES);
+
+    std::optional<ImpactResult> hit_opt;
+    Vector3D piece_start = toCurrentPose(start_m, t_start_s - reference_time_s);
+    float piece_t0 = t_start_s;
+    for(int k = 1; k <= pieces && !hit_opt.has_value(); ++k)
+    {
+      const float fraction = static_cast<float>(k) / static_cast<float>(pieces);
+      const float piece_t1 = t_start_s + (t_end_s - t_start_s) * fraction;
+      const Vector3D piece_end = toCurrentPose(start_m + (end_m - start_m) * fraction, piece_t1 - reference_time_s);
+      hit_opt = intersectSegment(piece_start, piece_end, piece_t0, piece_t1, bullet_radius);
+      piece_start = piece_end;
+      piece_t0 = piece_t1;
+    }
+    if(!hit_opt.has_value())
+    {
+      return std::nullopt;
+    }
+
+    // Carry the hit point and normal forward to the collider's pose at the hit time
+    ImpactResult hit = *hit_opt;
+    const float dt_hit = hit.time_s - reference_time_s;
+    Vector3D offset = hit.position_m - pivot;
+    if(angular_speed * std::fabs(dt_hit) > 1e-8f)
+    {
+      const Quaternion rotation = Quaternion::fromAxisAngle(axis, angular_speed * dt_hit);
+      offset = rotation.rotate(offset);
+      hit.normal = rotation.rotate(hit.normal);
+    }
+    hit.position_m = pivot + linear_velocity * dt_hit + offset;
+    return hit;
+  }
+
   bool Collider::segmentIntersectsAABB(const btk::math::Vector3D& start_m, const btk::math::Vector3D& end_m, const btk::math::Vector3D& min_bounds, const btk::math::Vector3D& max_bounds) const
   {
     // Slab method: project segment onto each axis and check for overlap
@@ -172,48 +320,7 @@ namespace btk::rendering
     return t_min <= t_max;
   }
 
-  std::optional<float> Collider::intersectTriangle(const btk::math::Vector3D& ray_origin, const btk::math::Vector3D& ray_dir, const btk::math::Vector3D& v0, const btk::math::Vector3D& v1,
-                                                   const btk::math::Vector3D& v2) const
-  {
-    // Möller–Trumbore intersection algorithm
-    constexpr float EPSILON = 1e-6f;
-
-    btk::math::Vector3D edge1 = v1 - v0;
-    btk::math::Vector3D edge2 = v2 - v0;
-    btk::math::Vector3D h = ray_dir.cross(edge2);
-    float a = edge1.dot(h);
-
-    if(std::fabs(a) < EPSILON)
-    {
-      return std::nullopt; // Ray parallel to triangle
-    }
-
-    float f = 1.0f / a;
-    btk::math::Vector3D s = ray_origin - v0;
-    float u = f * s.dot(h);
-
-    if(u < 0.0f || u > 1.0f)
-    {
-      return std::nullopt;
-    }
-
-    btk::math::Vector3D q = s.cross(edge1);
-    float v = f * ray_dir.dot(q);
-
-    if(v < 0.0f || u + v > 1.0f)
-    {
-      return std::nullopt;
-    }
-
-    float t = f * edge2.dot(q);
-
-    if(t >= 0.0f && t <= 1.0f)
-    {
-      return t;
-    }
 
-    return std::nullopt;
-  }
 
   std::optional<ImpactResult> Collider::intersectSegment(const btk::math::Vector3D& start_m, const btk::math::Vector3D& end_m, float t_start_s, float t_end_s, float bullet_radius) const
   {
@@ -251,58 +358,130 @@ namespace btk::rendering
       btk::math::Quaternion inv_rotation = rotation_.conjugate();
       Vector3D local_start = inv_rotation.rotate(start_m - position_);
       Vector3D local_end = inv_rotation.rotate(end_m - position_);
-      Vector3D local_ray_dir = local_end - local_start;
 
-      float closest_t = std::numeric_limits<float>::max();
-      Vector3D closest_hit_local;
+      float closest_t;
       Vector3D closest_normal_local;
-      bool found_hit = false;
-
-      // Test all triangles in local space
-      for(size_t i = 0; i < indices_.size(); i += 3)
+      if(!intersectMeshLocal(local_start, local_end - local_start, closest_t, closest_normal_local))
       {
-        const Vector3D& v0 = vertices_[indices_[i]];
-        const Vector3D& v1 = vertices_[indices_[i + 1]];
-        const Vector3D& v2 = vertices_[indices_[i + 2]];
+        return std::nullopt;
+      }
+
+      // Transform hit position and normal back to world space
+      Vector3D closest_hit_pos = start_m + (end_m - start_m) * closest_t;
+      Vector3D closest_normal = rotation_.rotate(closest_normal_local).normalized();
+
+      float time_s = t_start_s + (t_end_s - t_start_s) * closest_t;
+
+      return ImpactResult(closest_hit_pos, closest_normal, time_s, object_id_);
+    }
+  }
+
+  bool Collider::intersectMeshLocal(const btk::math::Vector3D& local_start, const btk::math::Vector3D& local_dir, float& hit_t, btk::math::Vector3D& hit_normal_local) const
+  {
+    using btk::math::Vector3D;
+
+    // Just past 1 so hits exactly at the segment end still count
+    float closest_t = 1.0f + std::numeric_limits<float>::epsilon();
+    uint32_t closest_triangle = 0;
+
+    // Walk the BVH nearest-first; each leaf's consecutive triangles are tested as SIMD blocks
+    const bool found_hit = bvh_.intersect(local_start, local_dir, closest_t, [&](uint32_t first, uint32_t count, float& t_max)
+                                          { return triangle_blocks_.intersect(local_start, local_dir, first, count, t_max, closest_triangle); });
 
-        auto t_opt = intersectTriangle(local_start, local_ray_dir, v0, v1, v2);
-        if(t_opt.has_value() && t_opt.value() < closest_t)
+    if(!found_hit)
+    {
+      return false;
+    }
+
+    const Vector3D& v0 = vertices_[indices_[closest_triangle * 3]];
+    const Vector3D& v1 = vertices_[indices_[closest_triangle * 3 + 1]];
+    const Vector3D& v2 = vertices_[indices_[closest_triangle * 3 + 2]];
+    hit_normal_local = (v1 - v0).cross(v2 - v0);
+
+    // Triangle normal in local space
+    float normal_len = hit_normal_local.magnitude();
+    if(normal_len > 1e-6f)
+    {
+      hit_normal_local = hit_normal_local / normal_len;
+    }
+    else
+    {
+      // Degenerate triangle - use default up vector
+      hit_normal_local = Vector3D(0, 1, 0);
+    }
+
+    hit_t = closest_t;
+    return true;
+  }
+
+  std::optional<ImpactResult> Collider::intersectPolyline(const btk::math::Vector3D* positions, const float* times, size_t segment_count, float bullet_radius, float reference_time_s) const
+  {
+    using btk::math::Vector3D;
+
+    if(isMoving())
+    {
+      // Each segment sees the collider's pose over its own time span
+      for(size_t i = 0; i < segment_count; ++i)
+      {
+        auto hit = intersectMovingSegment(positions[i], positions[i + 1], times[i], times[i + 1], bullet_radius, reference_time_s);
+        if(hit.has_value())
         {
-          closest_t = t_opt.value();
-          closest_hit_local = local_start + local_ray_dir * closest_t;
-
-          // Compute triangle normal in local space
-          Vector3D edge1 = v1 - v0;
-          Vector3D edge2 = v2 - v0;
-          Vector3D normal = edge1.cross(edge2);
-          float normal_len = normal.magnitude();
-          if(normal_len > 1e-6f)
-          {
-            closest_normal_local = normal / normal_len;
-          }
-          else
-          {
-            // Degenerate triangle - use default up vector
-            closest_normal_local = Vector3D(0, 1, 0);
-          }
+          return hit;
+        }
+      }
+      return std::nullopt;
+    }
 
-          found_hit = true;
+    if(steel_target_)
+    {
+      // Settled steel target: the plate's own test per segment
+      for(size_t i = 0; i < segment_count; ++i)
+      {
+        auto hit = intersectSegment(positions[i], positions[i + 1], times[i], times[i + 1], bullet_radius);
+        if(hit.has_value())
+        {
+          return hit;
         }
       }
+      return std::nullopt;
+    }
+
+    // Mesh mode: cheap world-space AABB rejection per segment; only overlapping segments are
+    // transformed to local space, and consecutive ones share their common endpoint
+    btk::math::Quaternion inv_rotation = rotation_.conjugate();
+    Vector3D local_start;
+    size_t local_start_index = segment_count + 1;
 
-      if(!found_hit)
+    for(size_t i = 0; i < segment_count; ++i)
+    {
+      const Vector3D& start_m = positions[i];
+      const Vector3D& end_m = positions[i + 1];
+      if(!segmentIntersectsAABB(start_m, end_m, min_bounds_m_, max_bounds_m_))
       {
-        return std::nullopt;
+        continue;
       }
 
-      // Transform hit position and normal back to world space
-      Vector3D closest_hit_pos = rotation_.rotate(closest_hit_local) + position_;
-      Vector3D closest_normal = rotation_.rotate(closest_normal_local).normalized();
+      if(local_start_index != i)
+      {
+        local_start = inv_rotation.rotate(start_m - position_);
+      }
+      Vector3D local_end = inv_rotation.rotate(end_m - position_);
 
-      float time_s = t_start_s + (t_end_s - t_start_s) * closest_t;
+      float hit_t;
+      Vector3D hit_normal_local;
+      if(intersectMeshLocal(local_start, local_end - local_start, hit_t, hit_normal_local))
+      {
+        Vector3D hit_pos = start_m + (end_m - start_m) * hit_t;
+        Vector3D normal = rotation_.rotate(hit_normal_local).normalized();
+        float time_s = times[i] + (times[i + 1] - times[i]) * hit_t;
+        return ImpactResult(hit_pos, normal, time_s, object_id_);
+      }
 
-      return ImpactResult(closest_hit_pos, closest_normal, time_s, object_id_);
+      local_start = local_end;
+      local_start_index = i + 1;
     }
+
+    return std::nullopt;
   }
 
   // ===== ImpactDetector =====
@@ -323,24 +502,25 @@ namespace btk::rendering
     if(bins_z_ <= 0)
       bins_z_ = 1;
 
-    grid_.resize(bins_x_ * bins_z_);
+    cell_offsets_.assign(static_cast<size_t>(bins_x_) * bins_z_ + 1, 0);
+    occupied_sat_.assign((static_cast<size_t>(bins_x_) + 1) * (bins_z_ + 1), 0);
   }
 
   void ImpactDetector::setColliderEnabled(int handle, bool enabled)
   {
-    auto it = colliders_.find(handle);
-    if(it != colliders_.end())
+    const int index = denseIndexOf(handle);
+    if(index >= 0)
     {
-      it->second.setEnabled(enabled);
+      colliders_[index].setEnabled(enabled);
     }
   }
 
   bool ImpactDetector::isColliderEnabled(int handle) const
   {
-    auto it = colliders_.find(handle);
-    if(it != colliders_.end())
+    const int index = denseIndexOf(handle);
+    if(index >= 0)
     {
-      return it->second.isEnabled();
+      return colliders_[index].isEnabled();
     }
     return false;
   }
@@ -357,278 +537,515 @@ namespace btk::rendering
     return std::clamp(idx, 0, bins_z_ - 1);
   }
 
-  int ImpactDetector::gridIndex(int bin_x, int bin_z) const
+  ImpactDetector::BinRect ImpactDetector::binRectOf(const Collider& collider) const
+  {
+    const btk::math::Vector3D& min_b = collider.minBounds();
+    const btk::math::Vector3D& max_b = collider.maxBounds();
+    return BinRect{binIndexX(min_b.x), binIndexX(max_b.x), binIndexZ(min_b.z), binIndexZ(max_b.z)};
+  }
+
+  int ImpactDetector::denseIndexOf(int handle) const
   {
-    if(bin_x < 0 || bin_x >= bins_x_ || bin_z < 0 || bin_z >= bins_z_)
+    if(handle < 0)
+    {
+      return -1;
+    }
+
+    const uint32_t slot = static_cast<uint32_t>(handle) & HANDLE_SLOT_MASK;
+    const uint32_t generation = static_cast<uint32_t>(handle) >> HANDLE_SLOT_BITS;
+    if(slot >= slots_.size() || !slots_[slot].alive || slots_[slot].generation != generation)
     {
       return -1;
     }
-    return bin_z * bins_x_ + bin_x;
+    return static_cast<int>(slots_[slot].dense_index);
   }
 
-#ifdef __EMSCRIPTEN__
-  int ImpactDetector::addMeshCollider(emscripten::val vertices_val, emscripten::val indices_val, int object_id)
+  int ImpactDetector::insertCollider(Collider&& collider, int object_id)
   {
-    // Convert JS typed arrays to C++ vectors using fast bulk conversion
-    std::vector<float> vertices;
-    std::vector<uint32_t> indices;
-
-    if(!vertices_val.isNull() && !vertices_val.isUndefined())
+    uint32_t slot;
+    if(!free_slots_.empty())
     {
-      vertices = emscripten::convertJSArrayToNumberVector<float>(vertices_val);
+      slot = free_slots_.back();
+      free_slots_.pop_back();
     }
-
-    if(!indices_val.isNull() && !indices_val.isUndefined())
+    else
     {
-      indices = emscripten::convertJSArrayToNumberVector<uint32_t>(indices_val);
+      if(slots_.size() > HANDLE_SLOT_MASK)
+      {
+        return -1; // Handle space exhausted
+      }
+      slot = static_cast<uint32_t>(slots_.size());
+      slots_.emplace_back();
     }
 
-    int handle = getNextHandle();
-    auto [it, inserted] = colliders_.emplace(handle, Collider(vertices, indices));
-    it->second.setObjectId(object_id);
+    collider.setObjectId(object_id);
 
-    // Geometry is already in world space, so compute bounds directly from vertices
-    // and use identity transform (position=0, rotation=identity)
-    // This ensures the collider is inserted into the correct grid bins
-    btk::math::Vector3D geom_min(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
-    btk::math::Vector3D geom_max(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
+    ColliderSlot& entry = slots_[slot];
+    entry.dense_index = static_cast<uint32_t>(colliders_.size());
+    entry.alive = true;
 
-    for(size_t i = 0; i < vertices.size(); i += 3)
-    {
-      float x = vertices[i];
-      float y = vertices[i + 1];
-      float z = vertices[i + 2];
-      geom_min.x = std::min(geom_min.x, x);
-      geom_min.y = std::min(geom_min.y, y);
-      geom_min.z = std::min(geom_min.z, z);
-      geom_max.x = std::max(geom_max.x, x);
-      geom_max.y = std::max(geom_max.y, y);
-      geom_max.z = std::max(geom_max.z, z);
-    }
+    collider_bins_.push_back(binRectOf(collider));
+    collider_slots_.push_back(slot);
+    colliders_.push_back(std::move(collider));
+    grid_dirty_ = true;
 
-    // Set transform to identity (geometry is already in world space)
-    // This ensures world bounds match the geometry bounds
-    it->second.setTransform(btk::math::Vector3D(0, 0, 0), btk::math::Quaternion::identity());
+    return static_cast<int>((entry.generation << HANDLE_SLOT_BITS) | slot);
+  }
 
-    Collider* collider_ptr = &it->second;
-    const btk::math::Vector3D& min_b = collider_ptr->minBounds();
-    const btk::math::Vector3D& max_b = collider_ptr->maxBounds();
+  void ImpactDetector::rebuildGrid() const
+  {
+    const size_t cell_count = cell_offsets_.size() - 1;
+    std::fill(cell_offsets_.begin(), cell_offsets_.end(), 0);
+
+    // Moving colliders are swept per query instead of being binned at one pose. Steel
+    // targets wake and settle on their own, so their state is kept to detect changes
+    moving_.clear();
+    steel_.clear();
+    for(uint32_t index = 0; index < static_cast<uint32_t>(colliders_.size()); ++index)
+    {
+      const bool moving = colliders_[index].isMoving();
+      if(moving)
+      {
+        moving_.push_back(index);
+      }
+      if(colliders_[index].isSteelTarget())
+      {
+        steel_.push_back(SteelEntry{index, moving});
+      }
+    }
 
-    int min_bin_x = binIndexX(min_b.x);
-    int max_bin_x = binIndexX(max_b.x);
-    int min_bin_z = binIndexZ(min_b.z);
-    int max_bin_z = binIndexZ(max_b.z);
+    // Count entries per cell (shifted by one), then prefix-sum into start offsets
+    for(uint32_t index = 0; index < static_cast<uint32_t>(collider_bins_.size()); ++index)
+    {
+      if(colliders_[index].isMoving())
+      {
+        continue;
+      }
+      const BinRect& rect = collider_bins_[index];
+      for(int bz = rect.min_z; bz <= rect.max_z; ++bz)
+      {
+        for(int bx = rect.min_x; bx <= rect.max_x; ++bx)
+        {
+          ++cell_offsets_[bz * bins_x_ + bx + 1];
+        }
+      }
+    }
+    for(size_t i = 1; i <= cell_count; ++i)
+    {
+      cell_offsets_[i] += cell_offsets_[i - 1];
+    }
+    cell_entries_.resize(cell_offsets_[cell_count]);
 
-    // Insert into all overlapping bins
-    for(int bz = min_bin_z; bz <= max_bin_z; ++bz)
+    // Scatter using each cell's start as a write cursor; afterwards every cursor sits at the next cell's start
+    for(uint32_t index = 0; index < static_cast<uint32_t>(collider_bins_.size()); ++index)
     {
-      for(int bx = min_bin_x; bx <= max_bin_x; ++bx)
+      if(colliders_[index].isMoving())
+      {
+        continue;
+      }
+      const BinRect& rect = collider_bins_[index];
+      for(int bz = rect.min_z; bz <= rect.max_z; ++bz)
       {
-        int gidx = gridIndex(bx, bz);
-        if(gidx >= 0)
+        for(int bx = rect.min_x; bx <= rect.max_x; ++bx)
         {
-          grid_[gidx].push_back(collider_ptr);
+          cell_entries_[cell_offsets_[bz * bins_x_ + bx]++] = index;
         }
       }
     }
+    for(size_t i = cell_count; i > 0; --i)
+    {
+      cell_offsets_[i] = cell_offsets_[i - 1];
+    }
+    cell_offsets_[0] = 0;
+
+    // Summed-area table of occupied bins, so whole polyline chunks over empty ground skip the bin walk
+    const size_t sat_stride = static_cast<size_t>(bins_x_) + 1;
+    occupied_sat_.assign(sat_stride * (bins_z_ + 1), 0);
+    for(int bz = 0; bz < bins_z_; ++bz)
+    {
+      uint32_t row_sum = 0;
+      for(int bx = 0; bx < bins_x_; ++bx)
+      {
+        const int gidx = bz * bins_x_ + bx;
+        row_sum += cell_offsets_[gidx + 1] != cell_offsets_[gidx] ? 1 : 0;
+        occupied_sat_[(bz + 1) * sat_stride + bx + 1] = occupied_sat_[bz * sat_stride + bx + 1] + row_sum;
+      }
+    }
 
-    return handle;
+    grid_dirty_ = false;
   }
-#endif
 
-  int ImpactDetector::addSteelCollider(btk::rendering::SteelTarget* target, float radius_m, int object_id)
+  bool ImpactDetector::steelMotionChanged() const
   {
-    if(!target)
+    for(const SteelEntry& entry : steel_)
     {
-      return -1;
+      if(colliders_[entry.index].isMoving() != entry.moving)
+      {
+        return true;
+      }
     }
+    return false;
+  }
 
-    int handle = getNextHandle();
-    auto [it, inserted] = colliders_.emplace(handle, Collider(target, radius_m));
-    it->second.setObjectId(object_id);
+  bool ImpactDetector::anyBinned(const btk::math::Vector3D& min_m, const btk::math::Vector3D& max_m) const
+  {
+    // Same clamped floor as traverseSegment, so every bin it could visit is covered
+    const float inv_bin = 1.0f / bin_size_m_;
+    const int bx0 = std::clamp(floorToInt((min_m.x - world_min_x_) * inv_bin), 0, bins_x_ - 1);
+    const int bx1 = std::clamp(floorToInt((max_m.x - world_min_x_) * inv_bin), 0, bins_x_ - 1);
+    const int bz0 = std::clamp(floorToInt((min_m.z - world_min_z_) * inv_bin), 0, bins_z_ - 1);
+    const int bz1 = std::clamp(floorToInt((max_m.z - world_min_z_) * inv_bin), 0, bins_z_ - 1);
+
+    const size_t sat_stride = static_cast<size_t>(bins_x_) + 1;
+    const uint32_t count = occupied_sat_[(bz1 + 1) * sat_stride + bx1 + 1] - occupied_sat_[bz0 * sat_stride + bx1 + 1] - occupied_sat_[(bz1 + 1) * sat_stride + bx0] + occupied_sat_[bz0 * sat_stride + bx0];
+    return count > 0;
+  }
 
-    Collider* collider_ptr = &it->second;
-    const btk::math::Vector3D& min_b = collider_ptr->minBounds();
-    const btk::math::Vector3D& max_b = collider_ptr->maxBounds();
+#ifdef __EMSCRIPTEN__
+  int ImpactDetector::addMeshCollider(emscripten::val vertices_val, emscripten::val indices_val, int object_id)
+  {
+    // Convert JS typed arrays to C++ vectors using fast bulk conversion
+    std::vector<float> vertices;
+    std::vector<uint32_t> indices;
 
-    int min_bin_x = binIndexX(min_b.x);
-    int max_bin_x = binIndexX(max_b.x);
-    int min_bin_z = binIndexZ(min_b.z);
-    int max_bin_z = binIndexZ(max_b.z);
+    if(!vertices_val.isNull() && !vertices_val.isUndefined())
+    {
+      vertices = emscripten::convertJSArrayToNumberVector<float>(vertices_val);
+    }
 
-    for(int bz = min_bin_z; bz <= max_bin_z; ++bz)
+    if(!indices_val.isNull() && !indices_val.isUndefined())
     {
-      for(int bx = min_bin_x; bx <= max_bin_x; ++bx)
-      {
-        int gidx = gridIndex(bx, bz);
-        if(gidx >= 0)
-        {
-          grid_[gidx].push_back(collider_ptr);
-        }
-      }
+      indices = emscripten::convertJSArrayToNumberVector<uint32_t>(indices_val);
     }
 
-    return handle;
+    return addMeshCollider(vertices, indices, object_id);
   }
+#endif
 
-  std::optional<ImpactResult> ImpactDetector::checkSegmentCollisions(const btk::math::Vector3D& start_m, const btk::math::Vector3D& end_m, float t_start_s, float t_end_s, float bullet_radius) const
+  int ImpactDetector::addMeshCollider(const std::vector<float>& vertices, const std::vector<uint32_t>& indices, int object_id)
   {
-    const float min_x = std::min(start_m.x, end_m.x);
-    const float max_x = std::max(start_m.x, end_m.x);
-    const float min_z = std::min(start_m.z, end_m.z);
-    const float max_z = std::max(start_m.z, end_m.z);
+    Collider collider(vertices, indices);
 
-    const int min_bin_x = binIndexX(min_x);
-    const int max_bin_x = binIndexX(max_x);
-    const int min_bin_z = binIndexZ(min_z);
-    const int max_bin_z = binIndexZ(max_z);
+    // Geometry is already in world space: use the identity transform so world bounds
+    // match the geometry bounds and the collider lands in the correct grid bins
+    collider.setTransform(btk::math::Vector3D(0, 0, 0), btk::math::Quaternion::identity());
 
-    std::optional<ImpactResult> earliest_hit;
-    float earliest_time = std::numeric_limits<float>::max();
+    return insertCollider(std::move(collider), object_id);
+  }
 
-    for(int bz = min_bin_z; bz <= max_bin_z; ++bz)
+  int ImpactDetector::addSteelCollider(btk::rendering::SteelTarget* target, float radius_m, int object_id)
+  {
+    if(!target)
     {
-      for(int bx = min_bin_x; bx <= max_bin_x; ++bx)
-      {
-        const int gidx = gridIndex(bx, bz);
-        if(gidx < 0)
-          continue;
+      return -1;
+    }
 
-        for(Collider* collider_ptr : grid_[gidx])
+    return insertCollider(Collider(target, radius_m), object_id);
+  }
+
+  template <typename Visitor>
+  void ImpactDetector::traverseSegment(const btk::math::Vector3D& start_m, const btk::math::Vector3D& end_m, float radius_m, Visitor&& visit) const
+  {
+    // Work in continuous bin coordinates
+    const float inv_bin = 1.0f / bin_size_m_;
+    const float gx0 = (start_m.x - world_min_x_) * inv_bin;
+    const float gz0 = (start_m.z - world_min_z_) * inv_bin;
+    const float dgx = (end_m.x - start_m.x) * inv_bin;
+    const float dgz = (end_m.z - start_m.z) * inv_bin;
+    const float gr = radius_m * inv_bin;
+    constexpr float INF = std::numeric_limits<float>::infinity();
+
+    // Short segments (the usual 1 ms trajectory step) touch at most 2x2 bins: visit the inflated box directly
+    {
+      const int bx0 = floorToInt(std::min(gx0, gx0 + dgx) - gr);
+      const int bx1 = floorToInt(std::max(gx0, gx0 + dgx) + gr);
+      const int bz0 = floorToInt(std::min(gz0, gz0 + dgz) - gr);
+      const int bz1 = floorToInt(std::max(gz0, gz0 + dgz) + gr);
+      if(bx1 - bx0 <= 1 && bz1 - bz0 <= 1)
+      {
+        // Clamp like binIndexX/binIndexZ so geometry outside the grid maps to the edge bins
+        const int cx0 = std::clamp(bx0, 0, bins_x_ - 1);
+        const int cx1 = std::clamp(bx1, 0, bins_x_ - 1);
+        const int cz0 = std::clamp(bz0, 0, bins_z_ - 1);
+        const int cz1 = std::clamp(bz1, 0, bins_z_ - 1);
+        BTK_PROFILE_COUNT(BROADPHASE_CELLS, (cx1 - cx0 + 1) * (cz1 - cz0 + 1));
+        for(int bz = cz0; bz <= cz1; ++bz)
         {
-          // Skip disabled colliders
-          if(!collider_ptr->isEnabled())
+          for(int bx = cx0; bx <= cx1; ++bx)
           {
-            continue;
+            visit(bz * bins_x_ + bx);
           }
+        }
+        return;
+      }
+    }
 
-          auto hit_opt = collider_ptr->intersectSegment(start_m, end_m, t_start_s, t_end_s, bullet_radius);
+    int cx = floorToInt(gx0);
+    int cz = floorToInt(gz0);
+    const int step_x = dgx > 0.0f ? 1 : -1;
+    const int step_z = dgz > 0.0f ? 1 : -1;
 
-          if(hit_opt.has_value())
-          {
-            if(hit_opt->time_s < earliest_time)
-            {
-              earliest_time = hit_opt->time_s;
-              earliest_hit = hit_opt;
-            }
-          }
+    // Parametric distance to the next bin boundary on each axis, and between boundaries
+    const float t_delta_x = dgx != 0.0f ? std::fabs(1.0f / dgx) : INF;
+    const float t_delta_z = dgz != 0.0f ? std::fabs(1.0f / dgz) : INF;
+    float t_max_x = dgx > 0.0f ? (static_cast<float>(cx + 1) - gx0) / dgx : (dgx < 0.0f ? (static_cast<float>(cx) - gx0) / dgx : INF);
+    float t_max_z = dgz > 0.0f ? (static_cast<float>(cz + 1) - gz0) / dgz : (dgz < 0.0f ? (static_cast<float>(cz) - gz0) / dgz : INF);
+
+    int remaining = std::abs(floorToInt(gx0 + dgx) - cx) + std::abs(floorToInt(gz0 + dgz) - cz);
+    float t_enter = 0.0f;
+
+    while(true)
+    {
+      const float t_exit = remaining > 0 ? std::min(std::min(t_max_x, t_max_z), 1.0f) : 1.0f;
+
+      // Part of the segment inside this bin, inflated by the radius; usually covers just this bin
+      const float xa = gx0 + dgx * t_enter;
+      const float xb = gx0 + dgx * t_exit;
+      const float za = gz0 + dgz * t_enter;
+      const float zb = gz0 + dgz * t_exit;
+      const int bx0 = std::clamp(floorToInt(std::min(xa, xb) - gr), 0, bins_x_ - 1);
+      const int bx1 = std::clamp(floorToInt(std::max(xa, xb) + gr), 0, bins_x_ - 1);
+      const int bz0 = std::clamp(floorToInt(std::min(za, zb) - gr), 0, bins_z_ - 1);
+      const int bz1 = std::clamp(floorToInt(std::max(za, zb) + gr), 0, bins_z_ - 1);
+      BTK_PROFILE_COUNT(BROADPHASE_CELLS, (bx1 - bx0 + 1) * (bz1 - bz0 + 1));
+      for(int bz = bz0; bz <= bz1; ++bz)
+      {
+        for(int bx = bx0; bx <= bx1; ++bx)
+        {
+          visit(bz * bins_x_ + bx);
         }
       }
-    }
 
-    return earliest_hit;
+      if(remaining-- <= 0)
+      {
+        break;
+      }
+
+      // Step into the next bin across the nearest boundary
+      if(t_max_x < t_max_z)
+      {
+        cx += step_x;
+        t_enter = t_max_x;
+        t_max_x += t_delta_x;
+      }
+      else
+      {
+        cz += step_z;
+        t_enter = t_max_z;
+        t_max_z += t_delta_z;
+      }
+    }
   }
 
-  void ImpactDetector::moveCollider(int handle, const btk::math::Vector3D& position, const btk::math::Quaternion& rotation)
+  std::optional<ImpactResult> ImpactDetector::checkPolylineCollisions(QueryScratch& scratch, const btk::math::Vector3D* positions, const float* times, size_t segment_count, float bullet_radius,
+                                                                      float reference_time_s) const
   {
-    auto it = colliders_.find(handle);
-    if(it == colliders_.end())
+    std::vector<PolylineCandidate>& candidates = scratch.candidates;
+    candidates.clear();
+    if(scratch.stamps.size() < colliders_.size())
     {
-      return; // Handle not found
+      scratch.stamps.resize(colliders_.size(), 0);
+      scratch.slots.resize(colliders_.size(), 0);
     }
 
-    auto& collider = it->second;
+    // Broadphase: walk the bins of every segment. Consecutive segments in the same bin form a run,
+    // and the mailbox stamp collects each collider of a run's bin once, widening its segment range
+    // instead of re-testing it per bin and per segment
+    const uint32_t stamp = ++scratch.stamp;
+    auto collect = [&](int gidx, size_t run_first, size_t run_last)
+    {
+      for(uint32_t e = cell_offsets_[gidx]; e < cell_offsets_[gidx + 1]; ++e)
+      {
+        const uint32_t index = cell_entries_[e];
+        if(scratch.stamps[index] != stamp)
+        {
+          scratch.stamps[index] = stamp;
+          scratch.slots[index] = static_cast<uint32_t>(candidates.size());
+          candidates.push_back({&colliders_[index], run_first, run_last});
+        }
+        else
+        {
+          PolylineCandidate& candidate = candidates[scratch.slots[index]];
+          candidate.first_segment = std::min(candidate.first_segment, run_first);
+          candidate.last_segment = std::max(candidate.last_segment, run_last);
+        }
+      }
+    };
+
+    // Chunks over empty bins (most of a long-range flight) skip the walk entirely
+    btk::math::Vector3D poly_min, poly_max;
+    polylineBounds(positions, segment_count, poly_min, poly_max);
+    const btk::math::Vector3D inflate(bullet_radius, bullet_radius, bullet_radius);
+    const bool any_binned = anyBinned(poly_min - inflate, poly_max + inflate);
+
+    int run_gidx = -1;
+    size_t run_first = 0;
+    size_t run_last = 0;
+    for(size_t i = 0; any_binned && i < segment_count; ++i)
+    {
+      traverseSegment(positions[i], positions[i + 1], bullet_radius,
+                      [&](int gidx)
+                      {
+                        if(gidx == run_gidx)
+                        {
+                          run_last = i;
+                          return;
+                        }
+                        if(run_gidx >= 0)
+                        {
+                          collect(run_gidx, run_first, run_last);
+                        }
+                        run_gidx = gidx;
+                        run_first = i;
+                        run_last = i;
+                      });
+    }
+    if(run_gidx >= 0)
+    {
+      collect(run_gidx, run_first, run_last);
+    }
 
-    // Get old bounds for grid removal
-    const auto old_min = collider.minBounds();
-    const auto old_max = collider.maxBounds();
+    // Narrowphase: one polyline test per collider, keep the earliest hit
+    std::optional<ImpactResult> earliest_hit = checkMovingCollisions(positions, times, segment_count, bullet_radius, reference_time_s);
+    float earliest_time = earliest_hit.has_value() ? earliest_hit->time_s : std::numeric_limits<float>::max();
 
-    // Update collider transform
-    collider.setTransform(position, rotation);
+    for(const PolylineCandidate& candidate : candidates)
+    {
+      // Skip disabled colliders
+      if(!candidate.collider->isEnabled())
+      {
+        continue;
+      }
 
-    // Get new bounds
-    const auto& new_min = collider.minBounds();
-    const auto& new_max = collider.maxBounds();
+      // Segments are time-ordered, so a run starting after the best hit cannot beat it
+      if(earliest_hit.has_value() && times[candidate.first_segment] > earliest_time)
+      {
+        continue;
+      }
 
-    // Check if grid cells changed
-    int old_min_x = binIndexX(old_min.x);
-    int old_max_x = binIndexX(old_max.x);
-    int old_min_z = binIndexZ(old_min.z);
-    int old_max_z = binIndexZ(old_max.z);
+      const size_t first = candidate.first_segment;
+      auto hit_opt = candidate.collider->intersectPolyline(positions + first, times + first, candidate.last_segment - first + 1, bullet_radius, reference_time_s);
+      if(hit_opt.has_value() && hit_opt->time_s < earliest_time)
+      {
+        earliest_time = hit_opt->time_s;
+        earliest_hit = hit_opt;
+      }
+    }
 
-    int new_min_x = binIndexX(new_min.x);
-    int new_max_x = binIndexX(new_max.x);
-    int new_min_z = binIndexZ(new_min.z);
-    int new_max_z = binIndexZ(new_max.z);
+    return earliest_hit;
+  }
 
-    if(old_min_x == new_min_x && old_max_x == new_max_x && old_min_z == new_min_z && old_max_z == new_max_z)
+  std::optional<ImpactResult> ImpactDetector::checkMovingCollisions(const btk::math::Vector3D* positions, const float* times, size_t segment_count, float bullet_radius, float reference_time_s) const
+  {
+    if(moving_.empty())
     {
-      return; // Same grid cells, no update needed
+      return std::nullopt;
     }
 
-    Collider* collider_ptr = &collider;
+    // Swept bounds over the polyline's time span against its bounds
+    btk::math::Vector3D poly_min, poly_max;
+    polylineBounds(positions, segment_count, poly_min, poly_max);
+    const float max_dt = std::max(std::fabs(times[0] - reference_time_s), std::fabs(times[segment_count] - reference_time_s));
 
-    // Remove from old cells
-    for(int bz = old_min_z; bz <= old_max_z; ++bz)
+    std::optional<ImpactResult> earliest_hit;
+    for(uint32_t index : moving_)
     {
-      for(int bx = old_min_x; bx <= old_max_x; ++bx)
+      const Collider& collider = colliders_[index];
+      if(!collider.isEnabled())
       {
-        int gidx = gridIndex(bx, bz);
-        if(gidx < 0)
-          continue;
+        continue;
+      }
 
-        auto& cell = grid_[gidx];
-        cell.erase(std::remove(cell.begin(), cell.end(), collider_ptr), cell.end());
+      btk::math::Vector3D swept_min, swept_max;
+      collider.sweptBounds(max_dt, swept_min, swept_max);
+      if(swept_min.x - bullet_radius > poly_max.x || swept_max.x + bullet_radius < poly_min.x || swept_min.y - bullet_radius > poly_max.y || swept_max.y + bullet_radius < poly_min.y ||
+         swept_min.z - bullet_radius > poly_max.z || swept_max.z + bullet_radius < poly_min.z)
+      {
+        continue;
       }
-    }
 
-    // Add to new cells
-    for(int bz = new_min_z; bz <= new_max_z; ++bz)
-    {
-      for(int bx = new_min_x; bx <= new_max_x; ++bx)
+      auto hit_opt = collider.intersectPolyline(positions, times, segment_count, bullet_radius, reference_time_s);
+      if(hit_opt.has_value() && (!earliest_hit.has_value() || hit_opt->time_s < earliest_hit->time_s))
       {
-        int gidx = gridIndex(bx, bz);
-        if(gidx >= 0)
-        {
-          grid_[gidx].push_back(collider_ptr);
-        }
+        earliest_hit = hit_opt;
       }
     }
+
+    return earliest_hit;
   }
 
-  void ImpactDetector::removeCollider(int handle)
+  void ImpactDetector::moveCollider(int handle, const btk::math::Vector3D& position, const btk::math::Quaternion& rotation)
   {
-    auto it = colliders_.find(handle);
-    if(it == colliders_.end())
+    const int index = denseIndexOf(handle);
+    if(index < 0)
     {
       return; // Handle not found
     }
 
-    Collider* collider_ptr = &it->second;
+    colliders_[index].setTransform(position, rotation);
 
-    // Remove from all grid cells
-    const auto& min_b = collider_ptr->minBounds();
-    const auto& max_b = collider_ptr->maxBounds();
-
-    for(int bz = binIndexZ(min_b.z); bz <= binIndexZ(max_b.z); ++bz)
+    // The grid only changes when a binned (non-moving) collider covers different bins
+    const BinRect rect = binRectOf(colliders_[index]);
+    if(!(rect == collider_bins_[index]))
     {
-      for(int bx = binIndexX(min_b.x); bx <= binIndexX(max_b.x); ++bx)
-      {
-        int gidx = gridIndex(bx, bz);
-        if(gidx < 0)
-          continue;
+      collider_bins_[index] = rect;
+      grid_dirty_ = grid_dirty_ || !colliders_[index].isMoving();
+    }
+  }
 
-        auto& cell = grid_[gidx];
-        cell.erase(std::remove(cell.begin(), cell.end(), collider_ptr), cell.end());
-      }
+  void ImpactDetector::setColliderVelocity(int handle, const btk::math::Vector3D& linear_velocity, const btk::math::Vector3D& angular_velocity)
+  {
+    const int index = denseIndexOf(handle);
+    if(index < 0)
+    {
+      return; // Handle not found
     }
 
-    // Remove from map
-    colliders_.erase(it);
+    // Starting or stopping moves the collider between the bins and the moving list
+    Collider& collider = colliders_[index];
+    const bool was_moving = collider.isMoving();
+    collider.setVelocity(linear_velocity, angular_velocity);
+    if(collider.isMoving() != was_moving)
+    {
+      grid_dirty_ = true;
+    }
   }
 
-  std::optional<ImpactResult> ImpactDetector::findFirstImpact(const btk::ballistics::Trajectory& trajectory, float t0_s, float t1_s) const
+  void ImpactDetector::removeCollider(int handle)
   {
-    const int point_count = static_cast<int>(trajectory.getPointCount());
-    if(point_count < 2)
+    const int index = denseIndexOf(handle);
+    if(index < 0)
     {
-      return std::nullopt;
+      return; // Handle not found
+    }
+
+    // Swap-remove from dense storage and repoint the moved collider's slot
+    const uint32_t last = static_cast<uint32_t>(colliders_.size() - 1);
+    if(static_cast<uint32_t>(index) != last)
+    {
+      colliders_[index] = std::move(colliders_[last]);
+      collider_bins_[index] = collider_bins_[last];
+      collider_slots_[index] = collider_slots_[last];
+      slots_[collider_slots_[index]].dense_index = static_cast<uint32_t>(index);
     }
+    colliders_.pop_back();
+    collider_bins_.pop_back();
+    collider_slots_.pop_back();
+
+    ColliderSlot& entry = slots_[static_cast<uint32_t>(handle) & HANDLE_SLOT_MASK];
+    entry.alive = false;
+    entry.generation = (entry.generation + 1) & HANDLE_GENERATION_MASK;
+    free_slots_.push_back(static_cast<uint32_t>(handle) & HANDLE_SLOT_MASK);
+
+    grid_dirty_ = true;
+  }
 
+  int ImpactDetector::windowStart(const btk::ballistics::Trajectory& trajectory, float t0_s)
+  {
     // Binary search for the last point at or before t0_s
     // This ensures we catch segments that straddle t0_s
     int left = 0;
-    int right = point_count - 1;
+    int right = static_cast<int>(trajectory.getPointCount()) - 1;
     int start_idx = 0;
 
     while(left <= right)
@@ -646,37 +1063,330 @@ namespace btk::rendering
       }
     }
 
-    // start_idx is now the last point <= t0_s, which is the start of a segment that might overlap [t0_s, t1_s]
+    return start_idx;
+  }
+
+  std::optional<ImpactResult> ImpactDetector::findFirstImpact(const btk::ballistics::Trajectory& trajectory, float t0_s, float t1_s) const
+  {
+    return findFirstImpact(trajectory, t0_s, t1_s, t0_s);
+  }
+
+  std::optional<ImpactResult> ImpactDetector::findFirstImpact(const btk::ballistics::Trajectory& trajectory, float t0_s, float t1_s, float reference_time_s) const
+  {
+    BTK_PROFILE_SCOPE(IMPACT_DETECTION);
+
+    const int point_count = static_cast<int>(trajectory.getPointCount());
+    if(point_count < 2)
+    {
+      return std::nullopt;
+    }
 
-    // Scan segments until we pass t1_s
-    for(int i = start_idx; i < point_count - 1; ++i)
+    if(grid_dirty_ || steelMotionChanged())
     {
-      const auto& p0 = trajectory.getPoint(i);
-      const auto& p1 = trajectory.getPoint(i + 1);
+      rebuildGrid();
+    }
 
-      const float seg_t0 = p0.getTime();
-      const float seg_t1 = p1.getTime();
+    const int start_idx = windowStart(trajectory, t0_s);
 
-      // Stop when segments are completely past t1_s
-      if(seg_t0 > t1_s)
-      {
-        break;
-      }
+    // start_idx is now the last point <= t0_s, which is the start of a segment that might overlap [t0_s, t1_s]
+    if(start_idx >= point_count - 1 || trajectory.getPoint(start_idx).getTime() > t1_s)
+    {
+      return std::nullopt;
+    }
 
-      const auto& start_m = p0.getPosition();
-      const auto& end_m = p1.getPosition();
-      const float bullet_radius = p0.getState().getDiameter() * 0.5f;
+    const auto& points = trajectory.getPoints();
+    const float bullet_radius = points[start_idx].getState().getDiameter() * 0.5f;
 
-      auto hit_opt = checkSegmentCollisions(start_m, end_m, seg_t0, seg_t1, bullet_radius);
+    // Test the window in time-ordered chunks so an early hit skips the rest of the trajectory.
+    // Each chunk's points are packed so the narrowphase walks compact arrays.
+    btk::math::Vector3D positions[POLYLINE_CHUNK_SEGMENTS + 1];
+    float times[POLYLINE_CHUNK_SEGMENTS + 1];
 
+    int chunk_start = start_idx;
+    while(chunk_start < point_count - 1 && points[chunk_start].getTime() <= t1_s)
+    {
+      // Gather segments until the chunk is full or segments start past t1_s
+      int segment_count = 0;
+      positions[0] = points[chunk_start].getPosition();
+      times[0] = points[chunk_start].getTime();
+      while(segment_count < POLYLINE_CHUNK_SEGMENTS && chunk_start + segment_count < point_count - 1 && times[segment_count] <= t1_s)
+      {
+        ++segment_count;
+        positions[segment_count] = points[chunk_start + segment_count].getPosition();
+        times[segment_count] = points[chunk_start + segment_count].getTime();
+      }
+
+      auto hit_opt = checkPolylineCollisions(scratch_, positions, times, segment_count, bullet_radius, reference_time_s);
       if(hit_opt.has_value())
       {
-        // Since segments are time-sorted, first hit is earliest hit
+        // Every collider touching this chunk was tested, and chunks are time-sorted
         return hit_opt;
       }
+      chunk_start += segment_count;
     }
 
     return std::nullopt;
   }
 
+  std::vector<ImpactResult> ImpactDetector::findFirstImpactBatch(const std::vector<btk::ballistics::Trajectory>& trajectories, float t0_s, float t1_s, int thread_count) const
+  {
+    BTK_PROFILE_SCOPE(IMPACT_DETECTION);
+
+    const size_t trajectory_count = trajectories.size();
+    std::vector<ImpactResult> results(trajectory_count);
+    if(trajectory_count == 0)
+    {
+      return results;
+    }
+
+    // Workers only read the grid, so it must be current before they start
+    if(grid_dirty_ || steelMotionChanged())
+    {
+      rebuildGrid();
+    }
+
+    // Same window as findFirstImpact: segments from the last point at or before t0_s through the
+    // last segment starting at or before t1_s. next_segment/end_segment track what is left to search
+    std::vector<uint32_t> next_segment(trajectory_count, 0);
+    std::vector<uint32_t> end_segment(trajectory_count, 0);
+    std::vector<float> radii(trajectory_count, 0.0f);
+    std::vector<float> hit_times(trajectory_count, std::numeric_limits<float>::max());
+    std::vector<uint32_t> active;
+    active.reserve(trajectory_count);
+    for(size_t i = 0; i < trajectory_count; ++i)
+    {
+      const btk::ballistics::Trajectory& trajectory = trajectories[i];
+      const int point_count = static_cast<int>(trajectory.getPointCount());
+      if(point_count < 2)
+      {
+        continue;
+      }
+      const int start_idx = windowStart(trajectory, t0_s);
+      if(start_idx < point_count - 1 && trajectory.getPoint(start_idx).getTime() <= t1_s)
+      {
+        next_segment[i] = static_cast<uint32_t>(start_idx);
+        end_segment[i] = static_cast<uint32_t>(std::min(windowStart(trajectory, t1_s), point_count - 2) + 1);
+        radii[i] = trajectory.getPoint(start_idx).getState().getDiameter() * 0.5f;
+        active.push_back(static_cast<uint32_t>(i));
+      }
+    }
+
+    const size_t cell_count = cell_offsets_.size() - 1;
+    const int worker_count = resolveThreadCount(thread_count, trajectory_count);
+    std::vector<std::vector<CellRun>> worker_runs(worker_count);
+    std::vector<std::vector<ImpactResult>> worker_hits(worker_count, std::vector<ImpactResult>(trajectory_count));
+    std::vector<std::vector<float>> worker_hit_times(worker_count, std::vector<float>(trajectory_count, std::numeric_limits<float>::max()));
+    std::vector<uint32_t> run_offsets(cell_count + 1);
+    std::vector<CellRun> sorted_runs;
+
+    // Pack up to POLYLINE_CHUNK_SEGMENTS segments of a trajectory into polyline arrays
+    auto packChunk = [&](uint32_t trajectory, uint32_t first_segment, uint32_t segment_count, btk::math::Vector3D* positions, float* times)
+    {
+      const auto& points = trajectories[trajectory].getPoints();
+      for(uint32_t k = 0; k <= segment_count; ++k)
+      {
+        positions[k] = points[first_segment + k].getPosition();
+        times[k] = points[first_segment + k].getTime();
+      }
+    };
+
+    // Trajectories advance in rounds so the search stops early for those that already hit, like the
+    // chunked single query; rounds grow so long misses do not pay for many short ones. Each round sorts
+    // every active trajectory's segment runs by grid bin, so a bin and its colliders are visited once
+    // for all trajectories crossing it
+    uint32_t round_segments = POLYLINE_CHUNK_SEGMENTS;
+    for(; !active.empty(); round_segments = std::min<uint32_t>(round_segments * 2, BATCH_MAX_ROUND_SEGMENTS))
+    {
+      // Broadphase, split by trajectory: record runs of segments per occupied bin, and test the
+      // moving colliders directly (they are not binned)
+      const int broadphase_workers = std::min(worker_count, static_cast<int>(active.size()));
+      runWorkers(broadphase_workers,
+                 [&](int worker)
+                 {
+                   std::vector<CellRun>& runs = worker_runs[worker];
+                   runs.clear();
+                   btk::math::Vector3D positions[POLYLINE_CHUNK_SEGMENTS + 1];
+                   float times[POLYLINE_CHUNK_SEGMENTS + 1];
+
+                   for(size_t a = active.size() * worker / broadphase_workers; a < active.size() * (worker + 1) / broadphase_workers; ++a)
+                   {
+                     const uint32_t i = active[a];
+                     const float radius = radii[i];
+                     const btk::math::Vector3D inflate(radius, radius, radius);
+                     const uint32_t round_begin = next_segment[i];
+                     const uint32_t round_end = std::min<uint32_t>(round_begin + round_segments, end_segment[i]);
+
+                     int run_gidx = -1;
+                     uint32_t run_first = 0;
+                     uint32_t run_last = 0;
+                     auto flush = [&]()
+                     {
+                       if(run_gidx >= 0 && cell_offsets_[run_gidx] != cell_offsets_[run_gidx + 1])
+                       {
+                         runs.push_back({static_cast<uint32_t>(run_gidx), i, run_first, run_last});
+                       }
+                     };
+                     // Chunks are packed once for both the bin walk and the moving colliders; they are
+                     // time-ordered, so a moving collider hit ends the search after its chunk
+                     for(uint32_t chunk = round_begin; chunk < round_end; chunk += POLYLINE_CHUNK_SEGMENTS)
+                     {
+                       const uint32_t chunk_segments = std::min<uint32_t>(POLYLINE_CHUNK_SEGMENTS, round_end - chunk);
+                       packChunk(i, chunk, chunk_segments, positions, times);
+                       btk::math::Vector3D chunk_min, chunk_max;
+                       polylineBounds(positions, chunk_segments, chunk_min, chunk_max);
+                       const bool any_binned = anyBinned(chunk_min - inflate, chunk_max + inflate);
+                       for(uint32_t j = 0; any_binned && j < chunk_segments; ++j)
+                       {
+                         const uint32_t k = chunk + j;
+                         traverseSegment(positions[j], positions[j + 1], radius,
+                                         [&](int gidx)
+                                         {
+                                           if(gidx == run_gidx)
+                                           {
+                                             run_last = k;
+                                             return;
+                                           }
+                                           flush();
+                                           run_gidx = gidx;
+                                           run_first = k;
+                                           run_last = k;
+                                         });
+                       }
+
+                       auto hit_opt = checkMovingCollisions(positions, times, chunk_segments, radius, t0_s);
+                       if(hit_opt.has_value())
+                       {
+                         results[i] = *hit_opt;
+                         hit_times[i] = hit_opt->time_s;
+                         break;
+                       }
+                     }
+                     flush();
+
+                     next_segment[i] = round_end;
+                   }
+                 });
+
+      // Sort this round's runs by bin (counting sort, stable so each bin lists trajectories in order)
+      std::fill(run_offsets.begin(), run_offsets.end(), 0);
+      for(int worker = 0; worker < broadphase_workers; ++worker)
+      {
+        for(const CellRun& run : worker_runs[worker])
+        {
+          ++run_offsets[run.cell + 1];
+        }
+      }
+      for(size_t c = 1; c <= cell_count; ++c)
+      {
+        run_offsets[c] += run_offsets[c - 1];
+      }
+      sorted_runs.resize(run_offsets[cell_count]);
+      for(int worker = 0; worker < broadphase_workers; ++worker)
+      {
+        for(const CellRun& run : worker_runs[worker])
+        {
+          sorted_runs[run_offsets[run.cell]++] = run;
+        }
+      }
+      for(size_t c = cell_count; c > 0; --c)
+      {
+        run_offsets[c] = run_offsets[c - 1];
+      }
+      run_offsets[0] = 0;
+
+      // Narrowphase, split by bin: each bin's colliders are tested against every run in that bin back to back.
+      // Workers keep their own earliest hits (hit_times stays read-only until the merge)
+      const int narrowphase_workers = std::min(worker_count, static_cast<int>(std::max<size_t>(1, sorted_runs.size())));
+      runWorkers(narrowphase_workers,
+                 [&](int worker)
+                 {
+                   // Balance by run count, aligned to bin boundaries
+                   const uint32_t run_begin = static_cast<uint32_t>(sorted_runs.size() * worker / narrowphase_workers);
+                   const uint32_t run_end = static_cast<uint32_t>(sorted_runs.size() * (worker + 1) / narrowphase_workers);
+                   const size_t cell_begin = worker == 0 ? 0 : std::upper_bound(run_offsets.begin(), run_offsets.end(), run_begin) - run_offsets.begin() - 1;
+                   const size_t cell_end = worker == narrowphase_workers - 1 ? cell_count : std::upper_bound(run_offsets.begin(), run_offsets.end(), run_end) - run_offsets.begin() - 1;
+
+                   std::vector<ImpactResult>& hits = worker_hits[worker];
+                   std::vector<float>& times_hit = worker_hit_times[worker];
+                   std::vector<btk::math::Vector3D> cell_positions;
+                   std::vector<float> cell_times;
+                   std::vector<uint32_t> run_points;
+
+                   for(size_t cell = cell_begin; cell < cell_end; ++cell)
+                   {
+                     if(run_offsets[cell] == run_offsets[cell + 1])
+                     {
+                       continue;
+                     }
+
+                     // Pack the bin's runs once; all of its colliders then walk the same compact arrays
+                     cell_positions.clear();
+                     cell_times.clear();
+                     run_points.clear();
+                     for(uint32_t r = run_offsets[cell]; r < run_offsets[cell + 1]; ++r)
+                     {
+                       const CellRun& run = sorted_runs[r];
+                       const auto& points = trajectories[run.trajectory].getPoints();
+                       run_points.push_back(static_cast<uint32_t>(cell_positions.size()));
+                       for(uint32_t k = run.first_segment; k <= run.last_segment + 1; ++k)
+                       {
+                         cell_positions.push_back(points[k].getPosition());
+                         cell_times.push_back(points[k].getTime());
+                       }
+                     }
+
+                     for(uint32_t e = cell_offsets_[cell]; e < cell_offsets_[cell + 1]; ++e)
+                     {
+                       const Collider& collider = colliders_[cell_entries_[e]];
+                       if(!collider.isEnabled())
+                       {
+                         continue;
+                       }
+
+                       for(uint32_t r = run_offsets[cell]; r < run_offsets[cell + 1]; ++r)
+                       {
+                         const CellRun& run = sorted_runs[r];
+                         const uint32_t base = run_points[r - run_offsets[cell]];
+                         const float best_time = std::min(hit_times[run.trajectory], times_hit[run.trajectory]);
+
+                         // Segments are time-ordered, so a run starting after the best hit cannot beat it
+                         if(cell_times[base] > best_time)
+                         {
+                           continue;
+                         }
+
+                         auto hit_opt = collider.intersectPolyline(&cell_positions[base], &cell_times[base], run.last_segment - run.first_segment + 1, radii[run.trajectory], t0_s);
+                         if(hit_opt.has_value() && hit_opt->time_s < best_time)
+                         {
+                           times_hit[run.trajectory] = hit_opt->time_s;
+                           hits[run.trajectory] = *hit_opt;
+                         }
+                       }
+                     }
+                   }
+                 });
+
+      // Merge worker hits, then retire trajectories that hit something or reached the end of their window
+      size_t still_active = 0;
+      for(uint32_t i : active)
+      {
+        for(int worker = 0; worker < narrowphase_workers; ++worker)
+        {
+          if(worker_hit_times[worker][i] < hit_times[i])
+          {
+            hit_times[i] = worker_hit_times[worker][i];
+            results[i] = worker_hits[worker][i];
+          }
+        }
+        if(hit_times[i] == std::numeric_limits<float>::max() && next_segment[i] < end_segment[i])
+        {
+          active[still_active++] = i;
+        }
+      }
+      active.resize(still_active);
+    }
+
+    return results;
+  }
+
 } // namespace btk::rendering
@@ -0,0 +1,202 @@
+#include "rendering/mesh_bvh.h"
+
+#include <algorithm>
+
+namespace btk::rendering
+{
+
+  namespace
+  {
+    using btk::math::Vector3D;
+
+    inline float axisValue(const Vector3D& v, int axis) { return axis == 0 ? v.x : (axis == 1 ? v.y : v.z); }
+
+    inline Vector3D minVector(const Vector3D& a, const Vector3D& b) { return Vector3D(std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)); }
+
+    inline Vector3D maxVector(const Vector3D& a, const Vector3D& b) { return Vector3D(std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)); }
+
+    // Half surface area is enough for SAH cost ratios
+    inline float halfArea(const Vector3D& min_bounds, const Vector3D& max_bounds)
+    {
+      Vector3D e = max_bounds - min_bounds;
+      return e.x * e.y + e.y * e.z + e.z * e.x;
+    }
+
+    struct Bounds
+    {
+      Vector3D min_bounds = Vector3D(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+      Vector3D max_bounds = Vector3D(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest());
+
+      void grow(const Vector3D& min_v, const Vector3D& max_v)
+      {
+        min_bounds = minVector(min_bounds, min_v);
+        max_bounds = maxVector(max_bounds, max_v);
+      }
+    };
+  } // namespace
+
+  void MeshBvh::build(const std::vector<btk::math::Vector3D>& vertices, std::vector<uint32_t>& indices)
+  {
+    nodes_.clear();
+
+    const uint32_t triangle_count = static_cast<uint32_t>(indices.size() / 3);
+    if(triangle_count == 0)
+    {
+      return;
+    }
+
+    std::vector<BuildTriangle> triangles(triangle_count);
+    for(uint32_t i = 0; i < triangle_count; ++i)
+    {
+      const Vector3D& v0 = vertices[indices[i * 3]];
+      const Vector3D& v1 = vertices[indices[i * 3 + 1]];
+      const Vector3D& v2 = vertices[indices[i * 3 + 2]];
+
+      BuildTriangle& tri = triangles[i];
+      tri.min_bounds = minVector(minVector(v0, v1), v2);
+      tri.max_bounds = maxVector(maxVector(v0, v1), v2);
+      tri.centroid = (tri.min_bounds + tri.max_bounds) * 0.5f;
+      tri.index = i;
+    }
+
+    nodes_.reserve(2 * triangle_count);
+    buildNode(triangles, 0, triangle_count, 0);
+    nodes_.shrink_to_fit();
+
+    // Reorder triangles so every leaf's range is contiguous in the index buffer
+    std::vector<uint32_t> reordered(indices.size());
+    for(uint32_t i = 0; i < triangle_count; ++i)
+    {
+      const uint32_t source = triangles[i].index * 3;
+      reordered[i * 3] = indices[source];
+      reordered[i * 3 + 1] = indices[source + 1];
+      reordered[i * 3 + 2] = indices[source + 2];
+    }
+    indices.swap(reordered);
+  }
+
+  uint32_t MeshBvh::buildNode(std::vector<BuildTriangle>& triangles, uint32_t first, uint32_t count, int depth)
+  {
+    const uint32_t node_index = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+
+    Bounds bounds;
+    Bounds centroid_bounds;
+    for(uint32_t i = first; i < first + count; ++i)
+    {
+      bounds.grow(triangles[i].min_bounds, triangles[i].max_bounds);
+      centroid_bounds.grow(triangles[i].centroid, triangles[i].centroid);
+    }
+    nodes_[node_index].min_bounds = bounds.min_bounds;
+    nodes_[node_index].max_bounds = bounds.max_bounds;
+
+    auto makeLeaf = [&]()
+    {
+      nodes_[node_index].offset = first;
+      nodes_[node_index].count = static_cast<uint16_t>(count);
+      nodes_[node_index].axis = 0;
+      return node_index;
+    };
+
+    if(count <= MAX_LEAF_TRIANGLES)
+    {
+      return makeLeaf();
+    }
+
+    // Split axis: longest extent of the centroids
+    const Vector3D extent = centroid_bounds.max_bounds - centroid_bounds.min_bounds;
+    int axis = 0;
+    if(extent.y > extent.x)
+    {
+      axis = 1;
+    }
+    if(extent.z > axisValue(extent, axis))
+    {
+      axis = 2;
+    }
+
+    const float axis_min = axisValue(centroid_bounds.min_bounds, axis);
+    const float axis_extent = axisValue(extent, axis);
+    uint32_t split = first + count / 2;
+    bool sah_split = false;
+
+    if(depth < MAX_SAH_DEPTH && axis_extent > 0.0f)
+    {
+      // Binned SAH: bucket centroids, then sweep the bucket boundaries
+      Bounds bin_bounds[SAH_BINS];
+      uint32_t bin_counts[SAH_BINS] = {};
+      const float bin_scale = SAH_BINS / axis_extent;
+      auto binOf = [&](const BuildTriangle& tri) { return std::min(SAH_BINS - 1, static_cast<int>((axisValue(tri.centroid, axis) - axis_min) * bin_scale)); };
+
+      for(uint32_t i = first; i < first + count; ++i)
+      {
+        const int bin = binOf(triangles[i]);
+        bin_bounds[bin].grow(triangles[i].min_bounds, triangles[i].max_bounds);
+        ++bin_counts[bin];
+      }
+
+      // Right-to-left prefix areas, then a left-to-right sweep for the cheapest boundary
+      float right_area[SAH_BINS];
+      uint32_t right_count[SAH_BINS];
+      Bounds accum;
+      uint32_t accum_count = 0;
+      for(int b = SAH_BINS - 1; b > 0; --b)
+      {
+        accum.grow(bin_bounds[b].min_bounds, bin_bounds[b].max_bounds);
+        accum_count += bin_counts[b];
+        right_area[b] = accum_count > 0 ? halfArea(accum.min_bounds, accum.max_bounds) : 0.0f;
+        right_count[b] = accum_count;
+      }
+
+      float best_cost = std::numeric_limits<float>::max();
+      int best_boundary = -1;
+      accum = Bounds();
+      accum_count = 0;
+      for(int b = 1; b < SAH_BINS; ++b)
+      {
+        accum.grow(bin_bounds[b - 1].min_bounds, bin_bounds[b - 1].max_bounds);
+        accum_count += bin_counts[b - 1];
+        if(accum_count == 0 || right_count[b] == 0)
+        {
+          continue;
+        }
+        const float cost = halfArea(accum.min_bounds, accum.max_bounds) * accum_count + right_area[b] * right_count[b];
+        if(cost < best_cost)
+        {
+          best_cost = cost;
+          best_boundary = b;
+        }
+      }
+
+      const float parent_area = halfArea(bounds.min_bounds, bounds.max_bounds);
+      const float split_cost = parent_area > 0.0f ? TRAVERSAL_COST + best_cost / parent_area : std::numeric_limits<float>::max();
+      if(best_boundary >= 0 && split_cost >= static_cast<float>(count) && count <= MAX_SAH_LEAF_TRIANGLES)
+      {
+        return makeLeaf();
+      }
+
+      if(best_boundary >= 0)
+      {
+        auto middle = std::partition(triangles.begin() + first, triangles.begin() + first + count, [&](const BuildTriangle& tri) { return binOf(tri) < best_boundary; });
+        split = static_cast<uint32_t>(middle - triangles.begin());
+        sah_split = true;
+      }
+    }
+
+    if(!sah_split)
+    {
+      // Median split: SAH depth exhausted, coincident centroids, or no usable boundary
+      std::nth_element(triangles.begin() + first, triangles.begin() + split, triangles.begin() + first + count,
+                       [&](const BuildTriangle& a, const BuildTriangle& b) { return axisValue(a.centroid, axis) < axisValue(b.centroid, axis); });
+    }
+
+    buildNode(triangles, first, split - first, depth + 1);
+    const uint32_t right = buildNode(triangles, split, first + count - split, depth + 1);
+
+    nodes_[node_index].offset = right;
+    nodes_[node_index].count = 0;
+    nodes_[node_index].axis = static_cast<uint16_t>(axis);
+    return node_index;
+  }
+
+} // namespace btk::rendering
@@ -2,6 +2,7 @@
 #include "math/conversions.h"
 #include "math/random.h"
 #include "physics/constants.h"
+#include "profiling/profiler.h"
 #include <algorithm>
 #include <cmath>
 #include <iostream>
@@ -121,30 +122,33 @@ namespace btk::rendering
       return std::nullopt;
     }
 
-    // Compute downrange distance (positive meters) of the target's plate corners
-    // using the same convention as TrajectoryPoint::getDistance() (distance = -Z).
+    // Get bullet radius for line break rule (bullet diameter doesn't change during flight)
+    float bullet_radius = trajectory.getPoint(0).getState().getDiameter() * 0.5f;
+
+    // Downrange extent of the plate outline in closed form, using the same convention as
+    // TrajectoryPoint::getDistance() (distance = -Z). The plate's in-plane axes are the local
+    // X/Y axes rotated into world space; only their Z components matter.
     float half_width = width_ * 0.5f;
     float half_height = height_ * 0.5f;
+    float axis_x_z = orientation_.rotate(Vector3D(1.0f, 0.0f, 0.0f)).z;
+    float axis_y_z = orientation_.rotate(Vector3D(0.0f, 1.0f, 0.0f)).z;
 
-    Vector3D corners_local[4] = {Vector3D(-half_width, -half_height, 0.0f), Vector3D(half_width, -half_height, 0.0f), Vector3D(half_width, half_height, 0.0f),
-                                 Vector3D(-half_width, half_height, 0.0f)};
-
-    float min_dist = std::numeric_limits<float>::max();
-    float max_dist = std::numeric_limits<float>::lowest();
-
-    for(const auto& c_local : corners_local)
+    float half_extent;
+    if(is_oval_)
     {
-      Vector3D c_world = position_ + orientation_.rotate(c_local);
-      float d = -c_world.z; // positive downrange distance
-      min_dist = std::min(min_dist, d);
-      max_dist = std::max(max_dist, d);
+      // Ellipse support function along Z
+      half_extent = std::sqrt(half_width * half_width * axis_x_z * axis_x_z + half_height * half_height * axis_y_z * axis_y_z);
     }
-
-    if(!(min_dist < max_dist))
+    else
     {
-      return std::nullopt;
+      half_extent = half_width * std::fabs(axis_x_z) + half_height * std::fabs(axis_y_z);
     }
 
+    // Pad by the bullet radius so contacts just before the plate are inside the segment
+    float center_dist = -position_.z;
+    float min_dist = center_dist - half_extent - bullet_radius;
+    float max_dist = center_dist + half_extent + bullet_radius;
+
     // Extract the trajectory segment that spans the target's downrange extent
     auto pt_start_opt = trajectory.atDistance(min_dist);
     auto pt_end_opt = trajectory.atDistance(max_dist);
@@ -156,9 +160,6 @@ namespace btk::rendering
     const Vector3D& p_start = pt_start_opt->getPosition();
     const Vector3D& p_end = pt_end_opt->getPosition();
 
-    // Get bullet radius for line break rule (bullet diameter doesn't change during flight)
-    float bullet_radius = pt_start_opt->getState().getDiameter() * 0.5f;
-
     // Raycast this segment into the target (with line break rule)
     auto hit_opt = intersectSegment(p_start, p_end, bullet_radius);
     if(!hit_opt.has_value())
@@ -166,10 +167,11 @@ namespace btk::rendering
       return std::nullopt;
     }
 
-    const Vector3D& hit_point = hit_opt->point_world_;
-    float hit_dist = -hit_point.z;
+    // Query the trajectory state where the bullet centre was at contact
+    float segment_length = (p_end - p_start).magnitude();
+    float t = segment_length > 1e-6f ? hit_opt->distance_m_ / segment_length : 0.0f;
+    float hit_dist = -(p_start.z + (p_end.z - p_start.z) * t);
 
-    // Query the trajectory state at the impact distance
     auto pt_hit_opt = trajectory.atDistance(hit_dist);
     if(!pt_hit_opt.has_value())
     {
@@ -198,42 +200,83 @@ namespace btk::rendering
       return std::nullopt;
     }
 
-    // Intersect segment with plate mid-plane at z = 0
-    // start_local.z + t * dir_local.z = 0  =>  t = -start_local.z / dir_local.z
-    float t = -start_local.z / dir_local.z;
-    if(t < 0.0f || t > 1.0f)
+    // Height of the bullet centre above the mid-plane on the side it starts from,
+    // and how fast that height closes per unit t (positive when approaching)
+    float side = start_local.z >= 0.0f ? 1.0f : -1.0f;
+    float height = start_local.z * side;
+    float closing = -dir_local.z * side;
+    if(closing <= 0.0f)
     {
-      // Intersection with plane lies outside the segment
       return std::nullopt;
     }
 
-    // Compute local-space intersection point
-    btk::math::Vector3D hit_local = start_local + dir_local * t;
-
-    // Check against finite plate extents in local XY
-    // Line break rule: expand bounds by bullet radius
-    float half_width = width_ * 0.5f + bullet_radius;
-    float half_height = height_ * 0.5f + bullet_radius;
+    float half_width = width_ * 0.5f;
+    float half_height = height_ * 0.5f;
 
-    bool inside = false;
-    if(is_oval_)
+    // Face contact: the bullet surface reaches the plate when its centre is bullet_radius
+    // from the mid-plane, and the centre then projects inside the plate outline
+    float t = std::max(height - bullet_radius, 0.0f) / closing;
+    btk::math::Vector3D hit_local;
+    bool hit = false;
+    if(t <= 1.0f)
     {
-      // Elliptical plate: (x/a)^2 + (y/b)^2 <= 1
-      // Expanded ellipse with bullet radius
-      float nx = hit_local.x / half_width;
-      float ny = hit_local.y / half_height;
-      inside = (nx * nx + ny * ny) <= 1.0f;
-    }
-    else
-    {
-      // Rectangular plate: |x| <= half_width, |y| <= half_height
-      // Expanded rectangle with bullet radius
-      inside = (std::fabs(hit_local.x) <= half_width) && (std::fabs(hit_local.y) <= half_height);
+      btk::math::Vector3D p = start_local + dir_local * t;
+      if(is_oval_)
+      {
+        // Elliptical plate: (x/a)^2 + (y/b)^2 <= 1
+        float nx = p.x / half_width;
+        float ny = p.y / half_height;
+        hit = (nx * nx + ny * ny) <= 1.0f;
+      }
+      else
+      {
+        // Rectangular plate: |x| <= half_width, |y| <= half_height
+        hit = (std::fabs(p.x) <= half_width) && (std::fabs(p.y) <= half_height);
+      }
+      hit_local = btk::math::Vector3D(p.x, p.y, 0.0f);
     }
 
-    if(!inside)
+    // Rim contact (line break rule): where the centre crosses the mid-plane within
+    // bullet_radius of the outline; the contact point is the nearest outline point
+    if(!hit)
     {
-      return std::nullopt;
+      t = height / closing;
+      if(t > 1.0f)
+      {
+        return std::nullopt;
+      }
+
+      btk::math::Vector3D p = start_local + dir_local * t;
+      if(is_oval_)
+      {
+        // Offset ellipse approximated by growing both semi-axes by the radius
+        float nx = p.x / (half_width + bullet_radius);
+        float ny = p.y / (half_height + bullet_radius);
+        if(nx * nx + ny * ny > 1.0f)
+        {
+          return std::nullopt;
+        }
+
+        // Pull the point radially onto the outline
+        float ex = p.x / half_width;
+        float ey = p.y / half_height;
+        float e = ex * ex + ey * ey;
+        float scale = e > 1.0f ? 1.0f / std::sqrt(e) : 1.0f;
+        hit_local = btk::math::Vector3D(p.x * scale, p.y * scale, 0.0f);
+      }
+      else
+      {
+        // Rounded rectangle: distance from the crossing point to the rectangle
+        float cx = std::clamp(p.x, -half_width, half_width);
+        float cy = std::clamp(p.y, -half_height, half_height);
+        float dx = p.x - cx;
+        float dy = p.y - cy;
+        if(dx * dx + dy * dy > bullet_radius * bullet_radius)
+        {
+          return std::nullopt;
+        }
+        hit_local = btk::math::Vector3D(cx, cy, 0.0f);
+      }
     }
 
     // Convert intersection point and normal back to world space
@@ -243,7 +286,7 @@ namespace btk::rendering
     // This matches the plate's facing direction used elsewhere.
     btk::math::Vector3D normal_world = normal_;
 
-    // Distance along the original world-space segment to the impact point
+    // Distance the bullet centre travelled along the world-space segment before contact
     float segment_length = (end - start).magnitude();
     float distance_m = segment_length * t;
 
@@ -348,18 +391,25 @@ namespace btk::rendering
 
   void SteelTarget::timeStep(float dt)
   {
+    BTK_PROFILE_SCOPE(STEEL_PHYSICS);
+
     // Clamp dt to maximum 1 second
     dt = std::min(dt, 1.0f);
 
-    // Subdivide into smaller steps if needed for stability
-    constexpr float MAX_SUBSTEP_DT = 0.001f; // 1ms maximum substep
-
-    // Subdivide into smaller steps if needed
-    int num_substeps = static_cast<int>(std::ceil(dt / MAX_SUBSTEP_DT));
+    // Subdivide into smaller steps: stiff springs need 1 ms for stability, while the
+    // implicit chain step is stable at any length and is only bounded for accuracy
+    int num_substeps = chain_solver_ == IMPLICIT ? implicitSubstepCount(dt, angular_velocity_.magnitude(), mass_kg_) : static_cast<int>(std::ceil(dt / MAX_SUBSTEP_DT));
     float substep_dt = dt / num_substeps;
+    BTK_PROFILE_COUNT(STEEL_SUBSTEPS, num_substeps);
 
     for(int i = 0; i < num_substeps; ++i)
     {
+      if(chain_solver_ == IMPLICIT)
+      {
+        implicitSubstep(substep_dt);
+        continue;
+      }
+
       // Apply gravity (BTK: Y is up, so gravity is in -Y direction)
       btk::math::Vector3D gravity_force(0.0f, -btk::physics::Constants::GRAVITY * mass_kg_, 0.0f);
       applyForce(gravity_force, position_, substep_dt);
@@ -444,14 +494,14 @@ namespace btk::rendering
         btk::math::Vector3D r = world_attachment - position_;
         btk::math::Vector3D attachment_velocity = velocity_ms_ + angular_velocity_.cross(r);
 
-        // Velocity component along chain direction (positive = extending)
+        // Velocity component along chain direction (positive = shortening, towards world_fixed)
         float velocity_along_chain = attachment_velocity.dot(direction);
 
         // Spring force: F = -k * x (restoring force)
         btk::math::Vector3D spring_force = direction * (SPRING_CONSTANT * extension);
 
         // Damping force: F = -c * v (dissipates energy, prevents bouncing)
-        // Only apply when extending (velocity > 0) - chains don't resist going slack
+        // Only applied to the rebound (velocity > 0), as the chain shortens
         btk::math::Vector3D damping_force(0.0f, 0.0f, 0.0f);
         if(velocity_along_chain > 0.0f)
         {
@@ -467,6 +517,64 @@ namespace btk::rendering
     }
   }
 
+  int SteelTarget::implicitSubstepCount(float dt, float angular_speed, float mass_kg)
+  {
+    // Bound the plate's rotation and the chain's oscillation phase per substep
+    float max_substep_dt = IMPLICIT_MAX_SUBSTEP_DT;
+    if(angular_speed > 0.0f)
+    {
+      max_substep_dt = std::min(max_substep_dt, IMPLICIT_MAX_ROTATION / angular_speed);
+    }
+    max_substep_dt = std::min(max_substep_dt, IMPLICIT_MAX_CHAIN_PHASE * std::sqrt(mass_kg / SPRING_CONSTANT));
+    return static_cast<int>(std::ceil(dt / max_substep_dt));
+  }
+
+  void SteelTarget::implicitSubstep(float dt)
+  {
+    velocity_ms_.y -= btk::physics::Constants::GRAVITY * dt;
+
+    // Chain impulses from a backward-Euler spring step, linearised along the chain:
+    // j = -dt * (k * x + (k * dt + c) * v) / (1 + dt * w * (k * dt + c)), with v the
+    // attachment speed away from world_fixed and w the inverse mass at the attachment.
+    // It tends to applyChainForces' impulse as dt shrinks, damping the same (shortening) motion.
+    for(const auto& anchor : anchors_)
+    {
+      btk::math::Vector3D r = orientation_.rotate(anchor.local_attachment_);
+      btk::math::Vector3D stretch = (position_ - anchor.world_fixed_) + r;
+      float distance = stretch.magnitude();
+      float extension = distance - anchor.rest_length_;
+      if(distance < 1e-6f || extension <= 0.0f)
+      {
+        continue;
+      }
+
+      // Inverse mass along the chain in local space, where the inertia tensor is diagonal
+      btk::math::Vector3D n = stretch / distance;
+      btk::math::Vector3D rn = anchor.local_attachment_.cross(orientation_.conjugate().rotate(n));
+      float inverse_mass = 1.0f / mass_kg_ + rn.x * rn.x / inertia_tensor_.x + rn.y * rn.y / inertia_tensor_.y + rn.z * rn.z / inertia_tensor_.z;
+
+      float speed = (velocity_ms_ + angular_velocity_.cross(r)).dot(n);
+      float stiffness = SPRING_CONSTANT * dt + (speed < 0.0f ? CHAIN_DAMPING : 0.0f);
+      float impulse = -dt * (SPRING_CONSTANT * extension + stiffness * speed) / (1.0f + dt * inverse_mass * stiffness);
+
+      velocity_ms_ += n * (impulse / mass_kg_);
+      angular_velocity_ += orientation_.rotate(btk::math::Vector3D(rn.x / inertia_tensor_.x, rn.y / inertia_tensor_.y, rn.z / inertia_tensor_.z) * impulse);
+    }
+
+    velocity_ms_ = velocity_ms_ * std::pow(LINEAR_DAMPING, dt);
+    angular_velocity_ = angular_velocity_ * std::pow(ANGULAR_DAMPING, dt);
+
+    // Semi-implicit Euler for the pose, as in the SPRING substep
+    position_ += velocity_ms_ * dt;
+    float angular_speed = angular_velocity_.magnitude();
+    if(angular_speed > 1e-6f)
+    {
+      orientation_ = btk::math::Quaternion::fromAxisAngle(angular_velocity_ / angular_speed, angular_speed * dt) * orientation_;
+      orientation_.normalize();
+    }
+    normal_ = orientation_.rotate(btk::math::Vector3D(0.0f, 0.0f, -1.0f));
+  }
+
   void SteelTarget::recordImpact(const btk::ballistics::Bullet& bullet)
   {
     // Convert bullet position and velocity to target-local coordinates
@@ -512,8 +620,11 @@ namespace btk::rendering
     // Store impact in local coordinates (use original position for physics, clamped for display)
     impacts_.emplace_back(local_pos_rotated, local_vel_rotated, bullet.getDiameter(), 0.0f);
 
-    // Draw impact using clamped position to ensure it's within texture bounds
-    drawImpactOnTexture(local_pos_clamped, bullet.getDiameter(), is_front_face);
+    // Decal uses clamped position to ensure it's within texture bounds
+    if(addDecal(local_pos_clamped, bullet.getDiameter(), is_front_face) && texture_enabled_)
+    {
+      drawDecalOnTexture(decals_.data() + decals_.size() - DECAL_STRIDE);
+    }
   }
 
 #ifdef __EMSCRIPTEN__
@@ -526,8 +637,90 @@ namespace btk::rendering
     }
     return val(typed_memory_view(texture_buffer_.size(), texture_buffer_.data()));
   }
+
+  emscripten::val SteelTarget::getDirtyTextureRows() const
+  {
+    using namespace emscripten;
+    if(!hasDirtyRect() || texture_buffer_.empty())
+    {
+      return val::global("Uint8Array").new_(0);
+    }
+    size_t row_bytes = static_cast<size_t>(texture_width_) * 4;
+    return val(typed_memory_view(static_cast<size_t>(dirty_max_y_ - dirty_min_y_) * row_bytes, texture_buffer_.data() + dirty_min_y_ * row_bytes));
+  }
+
+  emscripten::val SteelTarget::getMipLevel(int level) const
+  {
+    using namespace emscripten;
+    if(level < 1 || level >= getMipLevelCount())
+    {
+      throw std::invalid_argument("Mip level out of range");
+    }
+    const size_t size = static_cast<size_t>(getMipLevelWidth(level)) * getMipLevelHeight(level) * 4;
+    return val(typed_memory_view(size, mip_buffer_.data() + mip_offsets_[level - 1]));
+  }
+
+  emscripten::val SteelTarget::getDecals() const
+  {
+    using namespace emscripten;
+    if(decals_.empty())
+    {
+      return val::global("Float32Array").new_(0);
+    }
+    return val(typed_memory_view(decals_.size(), decals_.data()));
+  }
+#else
+  const uint8_t* SteelTarget::getMipLevel(int level) const
+  {
+    if(level < 1 || level >= getMipLevelCount())
+    {
+      throw std::invalid_argument("Mip level out of range");
+    }
+    return mip_buffer_.data() + mip_offsets_[level - 1];
+  }
 #endif
 
+  SteelTarget::DirtyRect SteelTarget::getDirtyRect() const
+  {
+    DirtyRect rect;
+    if(hasDirtyRect())
+    {
+      rect.x_ = dirty_min_x_;
+      rect.y_ = dirty_min_y_;
+      rect.width_ = dirty_max_x_ - dirty_min_x_;
+      rect.height_ = dirty_max_y_ - dirty_min_y_;
+    }
+    return rect;
+  }
+
+  void SteelTarget::clearDirtyRect()
+  {
+    dirty_min_x_ = 0;
+    dirty_min_y_ = 0;
+    dirty_max_x_ = 0;
+    dirty_max_y_ = 0;
+  }
+
+  void SteelTarget::markDirty(int min_x, int min_y, int max_x, int max_y)
+  {
+    if(max_x <= min_x || max_y <= min_y)
+    {
+      return;
+    }
+    if(!hasDirtyRect())
+    {
+      dirty_min_x_ = min_x;
+      dirty_min_y_ = min_y;
+      dirty_max_x_ = max_x;
+      dirty_max_y_ = max_y;
+      return;
+    }
+    dirty_min_x_ = std::min(dirty_min_x_, min_x);
+    dirty_min_y_ = std::min(dirty_min_y_, min_y);
+    dirty_max_x_ = std::max(dirty_max_x_, max_x);
+    dirty_max_y_ = std::max(dirty_max_y_, max_y);
+  }
+
   void SteelTarget::setColors(uint8_t paint_r, uint8_t paint_g, uint8_t paint_b, uint8_t metal_r, uint8_t metal_g, uint8_t metal_b)
   {
     paint_color_[0] = paint_r;
@@ -538,23 +731,213 @@ namespace btk::rendering
     metal_color_[2] = metal_b;
   }
 
+  void SteelTarget::setTextureEnabled(bool enabled)
+  {
+    if(enabled == texture_enabled_)
+    {
+      return;
+    }
+    texture_enabled_ = enabled;
+    if(!enabled)
+    {
+      // An atlas region stays allocated (and untouched) until the atlas releases it
+      std::vector<uint8_t>().swap(texture_buffer_);
+      allocateMips();
+      clearDirtyRect();
+      return;
+    }
+    repaintTexture();
+  }
+
+  void SteelTarget::setTextureSize(int texture_size)
+  {
+    if(texture_size <= 0)
+    {
+      throw std::invalid_argument("Texture size must be positive");
+    }
+    if(shared_texture_data_ != nullptr)
+    {
+      throw std::invalid_argument("Texture size of a target in a SteelTextureAtlas is set by the atlas");
+    }
+    texture_width_ = texture_size * 2;
+    texture_height_ = texture_size;
+    clearDirtyRect();
+    repaintTexture();
+  }
+
+  int SteelTarget::textureSizeFor(float plate_size_m, float distance_m, float fov_y_rad, int viewport_height_px, float texels_per_pixel, int max_size)
+  {
+    // Screen pixels spanned by the plate (small-angle projection)
+    const float view_height_m = 2.0f * std::max(distance_m, 1e-3f) * std::tan(0.5f * fov_y_rad);
+    const float wanted = plate_size_m / view_height_m * viewport_height_px * texels_per_pixel;
+
+    int size = 16;
+    while(size < max_size && static_cast<float>(size) < wanted)
+    {
+      size *= 2;
+    }
+    return size;
+  }
+
+  void SteelTarget::setMipmapsEnabled(bool enabled)
+  {
+    if(enabled == mipmaps_enabled_)
+    {
+      return;
+    }
+    mipmaps_enabled_ = enabled;
+    allocateMips();
+    if(!mip_offsets_.empty())
+    {
+      updateMips(0, 0, texture_width_, texture_height_);
+    }
+  }
+
+  void SteelTarget::allocateMips()
+  {
+    mip_offsets_.clear();
+    if(!mipmaps_enabled_ || !texture_enabled_)
+    {
+      std::vector<uint8_t>().swap(mip_buffer_);
+      return;
+    }
+
+    size_t total = 0;
+    int width = texture_width_;
+    int height = texture_height_;
+    while(width > 1 || height > 1)
+    {
+      width = std::max(1, width / 2);
+      height = std::max(1, height / 2);
+      mip_offsets_.push_back(total);
+      total += static_cast<size_t>(width) * height * 4;
+    }
+    mip_buffer_.resize(total);
+  }
+
+  void SteelTarget::updateMips(int min_x, int min_y, int max_x, int max_y)
+  {
+    const uint8_t* src = textureData();
+    size_t src_row_bytes = texture_row_bytes_;
+    int src_width = texture_width_;
+    int src_height = texture_height_;
+
+    for(size_t level = 0; level < mip_offsets_.size(); ++level)
+    {
+      const int dst_width = std::max(1, src_width / 2);
+      const int dst_height = std::max(1, src_height / 2);
+      uint8_t* dst = mip_buffer_.data() + mip_offsets_[level];
+      const size_t dst_row_bytes = static_cast<size_t>(dst_width) * 4;
+
+      // Texels of this level whose 2x2 footprint touches the changed region
+      min_x = min_x / 2;
+      min_y = min_y / 2;
+      max_x = std::min(dst_width, (max_x + 1) / 2);
+      max_y = std::min(dst_height, (max_y + 1) / 2);
+
+      for(int y = min_y; y < max_y; ++y)
+      {
+        const uint8_t* row0 = src + std::min(2 * y, src_height - 1) * src_row_bytes;
+        const uint8_t* row1 = src + std::min(2 * y + 1, src_height - 1) * src_row_bytes;
+        uint8_t* out = dst + y * dst_row_bytes;
+        for(int x = min_x; x < max_x; ++x)
+        {
+          const int x0 = std::min(2 * x, src_width - 1) * 4;
+          const int x1 = std::min(2 * x + 1, src_width - 1) * 4;
+          for(int c = 0; c < 4; ++c)
+          {
+            out[x * 4 + c] = static_cast<uint8_t>((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) / 4);
+          }
+        }
+      }
+
+      src = dst;
+      src_row_bytes = dst_row_bytes;
+      src_width = dst_width;
+      src_height = dst_height;
+    }
+  }
+
+  void SteelTarget::repaintTexture()
+  {
+    initializeTexture();
+    if(!texture_enabled_)
+    {
+      return;
+    }
+    for(size_t i = 0; i < decals_.size(); i += DECAL_STRIDE)
+    {
+      drawDecalOnTexture(decals_.data() + i);
+    }
+  }
+
+  void SteelTarget::bindTextureStorage(uint8_t* data, size_t row_bytes, int texture_size)
+  {
+    std::vector<uint8_t>().swap(texture_buffer_);
+    shared_texture_data_ = data;
+    texture_row_bytes_ = row_bytes;
+    texture_width_ = texture_size * 2;
+    texture_height_ = texture_size;
+    clearDirtyRect();
+    repaintTexture();
+  }
+
+  void SteelTarget::unbindTextureStorage()
+  {
+    shared_texture_data_ = nullptr;
+    clearDirtyRect();
+    repaintTexture();
+  }
+
   void SteelTarget::initializeTexture()
   {
-    // texture_width_ and texture_height_ set by constructor
-    size_t pixel_count = texture_width_ * texture_height_;
-    texture_buffer_.resize(pixel_count * 4);
+    if(!texture_enabled_)
+    {
+      return;
+    }
+
+    // texture_width_ and texture_height_ set by constructor (or the atlas region)
+    if(shared_texture_data_ == nullptr)
+    {
+      texture_buffer_.resize(static_cast<size_t>(texture_width_) * texture_height_ * 4);
+      texture_row_bytes_ = static_cast<size_t>(texture_width_) * 4;
+    }
+    uint8_t* data = textureData();
 
     // Fill entire texture with paint color (fully opaque)
-    for(size_t i = 0; i < pixel_count; ++i)
+    for(int y = 0; y < texture_height_; ++y)
     {
-      texture_buffer_[i * 4 + 0] = paint_color_[0]; // R
-      texture_buffer_[i * 4 + 1] = paint_color_[1]; // G
-      texture_buffer_[i * 4 + 2] = paint_color_[2]; // B
-      texture_buffer_[i * 4 + 3] = 255;             // A
+      uint8_t* row = data + y * texture_row_bytes_;
+      for(int x = 0; x < texture_width_; ++x)
+      {
+        row[x * 4 + 0] = paint_color_[0]; // R
+        row[x * 4 + 1] = paint_color_[1]; // G
+        row[x * 4 + 2] = paint_color_[2]; // B
+        row[x * 4 + 3] = 255;             // A
+      }
     }
+    markDirty(0, 0, texture_width_, texture_height_);
+
+    allocateMips();
+    if(!mip_offsets_.empty())
+    {
+      updateMips(0, 0, texture_width_, texture_height_);
+    }
+  }
+
+  float SteelTarget::decalRandom(uint32_t seed, uint32_t index)
+  {
+    // lowbias32 (Wellons); mirrored in the steel-sim impact shader
+    uint32_t x = seed * 0x9E3779B9u + index;
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return static_cast<float>(x >> 8) * (1.0f / 16777216.0f);
   }
 
-  void SteelTarget::drawImpactOnTexture(const btk::math::Vector3D& local_position, float bullet_diameter, bool is_front_face)
+  bool SteelTarget::addDecal(const btk::math::Vector3D& local_position, float bullet_diameter, bool is_front_face)
   {
     // In local frame, target is in XY plane (Z is normal)
     // Map X and Y to UV coordinates [0, 1]
@@ -564,9 +947,37 @@ namespace btk::rendering
     // Skip if outside texture bounds
     if(u < 0.0f || u > 1.0f || v < 0.0f || v > 1.0f)
     {
-      return;
+      return false;
     }
 
+    // Splatter radius based on bullet diameter, per axis so the mark is circular on the plate
+    float splatter_radius_m = bullet_diameter * 3.0f; // 3x bullet diameter
+
+    // 24-bit seed stays exact when stored as float
+    uint32_t seed = btk::math::Random::next() & 0xFFFFFFu;
+    int num_spikes = 6 + static_cast<int>(decalRandom(seed, 0) * 9.0f); // 10 +/- 4
+
+    decals_.push_back(u);
+    decals_.push_back(v);
+    decals_.push_back(splatter_radius_m / width_);
+    decals_.push_back(splatter_radius_m / height_);
+    decals_.push_back(is_front_face ? 0.0f : 1.0f);
+    decals_.push_back(static_cast<float>(seed));
+    decals_.push_back(static_cast<float>(num_spikes));
+    decals_.push_back(0.0f);
+    return true;
+  }
+
+  void SteelTarget::drawDecalOnTexture(const float* decal)
+  {
+    BTK_PROFILE_SCOPE(TEXTURE_PAINT);
+
+    float u = decal[0];
+    float v = decal[1];
+    bool is_front_face = decal[4] == 0.0f;
+    uint32_t seed = static_cast<uint32_t>(decal[5]);
+    int num_spikes = static_cast<int>(decal[6]);
+
     // Texture is split: left half = front face (u=0-0.5), right half = back face (u=0.5-1.0)
     // Scale u to half width and offset to correct half
     int half_texture_width = texture_width_ / 2;
@@ -580,68 +991,83 @@ namespace btk::rendering
     int u_min = is_front_face ? 0 : half_texture_width;
     int u_max = is_front_face ? half_texture_width : texture_width_;
 
-    // Draw splatter as a circle revealing metal underneath
-    // Splatter radius based on bullet diameter (scaled to texture space)
-    float splatter_radius_m = bullet_diameter * 3.0f; // 3x bullet diameter
-
-    // Calculate radius in pixels for X and Y separately to account for aspect ratio
+    // Radius in pixels for X and Y separately to account for aspect ratio
     // Half texture width maps to target width, full texture height maps to target height
-    int splatter_radius_px_x = static_cast<int>((splatter_radius_m / width_) * half_texture_width);
-    int splatter_radius_px_y = static_cast<int>((splatter_radius_m / height_) * texture_height_);
+    int splatter_radius_px_x = static_cast<int>(decal[2] * half_texture_width);
+    int splatter_radius_px_y = static_cast<int>(decal[3] * texture_height_);
     splatter_radius_px_x = std::max(3, splatter_radius_px_x);
     splatter_radius_px_y = std::max(3, splatter_radius_px_y);
 
+    uint8_t* texture = textureData();
+
+    // Bounds of the texels actually written, for the dirty rectangle
+    int painted_min_x = u_max;
+    int painted_min_y = texture_height_;
+    int painted_max_x = u_min;
+    int painted_max_y = 0;
+    int pixels_written = 0;
+
     // Draw ellipse that appears circular on the target
+    float inv_radius_x = 1.0f / splatter_radius_px_x;
+    float inv_radius_y = 1.0f / splatter_radius_px_y;
     for(int dy = -splatter_radius_px_y; dy <= splatter_radius_px_y; ++dy)
     {
+      int py = center_y + dy;
+      if(py < 0 || py >= texture_height_)
+        continue;
+
+      float ny = dy * inv_radius_y;
       for(int dx = -splatter_radius_px_x; dx <= splatter_radius_px_x; ++dx)
       {
         int px = center_x + dx;
-        int py = center_y + dy;
 
         // Check bounds - confine to correct half of texture
-        if(px < u_min || px >= u_max || py < 0 || py >= texture_height_)
+        if(px < u_min || px >= u_max)
           continue;
 
-        // Calculate normalized distance (ellipse equation: (dx/rx)^2 + (dy/ry)^2 <= 1)
-        float nx = static_cast<float>(dx) / splatter_radius_px_x;
-        float ny = static_cast<float>(dy) / splatter_radius_px_y;
-        float dist = std::sqrt(nx * nx + ny * ny);
+        // Ellipse equation: (dx/rx)^2 + (dy/ry)^2 <= 1
+        float nx = dx * inv_radius_x;
+        float dist_sq = nx * nx + ny * ny;
 
-        if(dist <= 1.0f)
+        if(dist_sq <= 1.0f)
         {
-          // Blend from metal (center) to paint (edge)
-          float blend = dist * dist; // Quadratic falloff for softer edge (dist is already 0-1)
+          // Blend from metal (center) to paint (edge) with quadratic falloff
+          float blend = dist_sq;
 
-          size_t pixel_idx = (py * texture_width_ + px) * 4;
+          size_t pixel_idx = py * texture_row_bytes_ + px * 4;
 
           // Blend between metal and paint colors
-          texture_buffer_[pixel_idx + 0] = static_cast<uint8_t>(metal_color_[0] * (1.0f - blend) + paint_color_[0] * blend);
-          texture_buffer_[pixel_idx + 1] = static_cast<uint8_t>(metal_color_[1] * (1.0f - blend) + paint_color_[1] * blend);
-          texture_buffer_[pixel_idx + 2] = static_cast<uint8_t>(metal_color_[2] * (1.0f - blend) + paint_color_[2] * blend);
-          texture_buffer_[pixel_idx + 3] = 255; // Fully opaque
+          texture[pixel_idx + 0] = static_cast<uint8_t>(metal_color_[0] * (1.0f - blend) + paint_color_[0] * blend);
+          texture[pixel_idx + 1] = static_cast<uint8_t>(metal_color_[1] * (1.0f - blend) + paint_color_[1] * blend);
+          texture[pixel_idx + 2] = static_cast<uint8_t>(metal_color_[2] * (1.0f - blend) + paint_color_[2] * blend);
+          texture[pixel_idx + 3] = 255; // Fully opaque
+          ++pixels_written;
+
+          painted_min_x = std::min(painted_min_x, px);
+          painted_min_y = std::min(painted_min_y, py);
+          painted_max_x = std::max(painted_max_x, px + 1);
+          painted_max_y = std::max(painted_max_y, py + 1);
         }
       }
     }
 
     // Draw sharp spikes radiating outward
-    int num_spikes = 10 + btk::math::Random::uniformInt(-4, 4);
-
     for(int spike = 0; spike < num_spikes; ++spike)
     {
-      // Base angle evenly distributed, with random variation
+      uint32_t k = static_cast<uint32_t>(spike) * 3;
+
+      // Base angle evenly distributed, with seeded variation
       float base_angle = (2.0f * M_PI_F * spike) / num_spikes;
-      float angle_variation = btk::math::Random::uniform(-0.3f, 0.3f);
+      float angle_variation = -0.3f + 0.6f * decalRandom(seed, k + 1);
       float angle = base_angle + angle_variation;
 
       // Direction in normalized space, then scale by aspect ratio for pixel space
       float dir_nx = std::cos(angle);
       float dir_ny = std::sin(angle);
 
-      // Random spike length (in normalized units, like splatter radius)
-      float length_randomness = btk::math::Random::uniform(0.8f, 1.2f);
-      float spike_length_norm = 3.0f * length_randomness; // 3x splatter radius
-      float spike_width = 2.5f * btk::math::Random::uniform(0.8f, 1.2f);
+      // Spike length in normalized units (like splatter radius), width in pixels
+      float spike_length_norm = 3.0f * (0.8f + 0.4f * decalRandom(seed, k + 2)); // 3x splatter radius
+      float spike_width = 2.5f * (0.8f + 0.4f * decalRandom(seed, k + 3));
 
       // Draw spike as a thin triangle
       for(float t = 0.0f; t < spike_length_norm; t += 0.05f)
@@ -652,6 +1078,13 @@ namespace btk::rendering
         int spike_x = center_x + static_cast<int>(dir_nx * t * splatter_radius_px_x);
         int spike_y = center_y + static_cast<int>(dir_ny * t * splatter_radius_px_y);
 
+        // Fade spike from metal to paint along its length (quadratic falloff)
+        float fade = t / spike_length_norm;
+        fade = fade * fade;
+        uint8_t r = static_cast<uint8_t>(metal_color_[0] * (1.0f - fade) + paint_color_[0] * fade);
+        uint8_t g = static_cast<uint8_t>(metal_color_[1] * (1.0f - fade) + paint_color_[1] * fade);
+        uint8_t b = static_cast<uint8_t>(metal_color_[2] * (1.0f - fade) + paint_color_[2] * fade);
+
         // Draw width of spike at this point
         for(int w = -static_cast<int>(width_at_t); w <= static_cast<int>(width_at_t); ++w)
         {
@@ -661,20 +1094,28 @@ namespace btk::rendering
           // Check bounds - confine to correct half of texture
           if(px >= u_min && px < u_max && py >= 0 && py < texture_height_)
           {
-            size_t pixel_idx = (py * texture_width_ + px) * 4;
-
-            // Fade spike from metal to paint along its length
-            float fade = t / spike_length_norm;
-            fade = fade * fade; // Quadratic falloff
-
-            texture_buffer_[pixel_idx + 0] = static_cast<uint8_t>(metal_color_[0] * (1.0f - fade) + paint_color_[0] * fade);
-            texture_buffer_[pixel_idx + 1] = static_cast<uint8_t>(metal_color_[1] * (1.0f - fade) + paint_color_[1] * fade);
-            texture_buffer_[pixel_idx + 2] = static_cast<uint8_t>(metal_color_[2] * (1.0f - fade) + paint_color_[2] * fade);
-            texture_buffer_[pixel_idx + 3] = 255;
+            size_t pixel_idx = py * texture_row_bytes_ + px * 4;
+            texture[pixel_idx + 0] = r;
+            texture[pixel_idx + 1] = g;
+            texture[pixel_idx + 2] = b;
+            texture[pixel_idx + 3] = 255;
+            ++pixels_written;
+
+            painted_min_x = std::min(painted_min_x, px);
+            painted_min_y = std::min(painted_min_y, py);
+            painted_max_x = std::max(painted_max_x, px + 1);
+            painted_max_y = std::max(painted_max_y, py + 1);
           }
         }
       }
     }
+
+    BTK_PROFILE_COUNT(TEXTURE_PIXELS, pixels_written);
+    markDirty(painted_min_x, painted_min_y, painted_max_x, painted_max_y);
+    if(!mip_offsets_.empty() && painted_max_x > painted_min_x)
+    {
+      updateMips(painted_min_x, painted_min_y, painted_max_x, painted_max_y);
+    }
   }
 
 } // namespace btk::rendering
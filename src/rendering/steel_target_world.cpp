@@ -0,0 +1,518 @@
+#include "rendering/steel_target_world.h"
+#include "physics/constants.h"
+#include "profiling/profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace btk::rendering
+{
+
+  using namespace btk::math::simd;
+
+  namespace
+  {
+    inline vfloat sqrtLanes(vfloat v)
+    {
+      vfloat result = v;
+      for(int lane = 0; lane < NATIVE_WIDTH; ++lane)
+      {
+        result[lane] = std::sqrt(v[lane]);
+      }
+      return result;
+    }
+
+    /// Lane-wise Quaternion::rotate (v' = v + 2w (q x v) + 2 q x (q x v))
+    inline void rotateLanes(vfloat q_w, vfloat q_x, vfloat q_y, vfloat q_z, vfloat v_x, vfloat v_y, vfloat v_z, vfloat& out_x, vfloat& out_y, vfloat& out_z)
+    {
+      const vfloat c1_x = q_y * v_z - q_z * v_y;
+      const vfloat c1_y = q_z * v_x - q_x * v_z;
+      const vfloat c1_z = q_x * v_y - q_y * v_x;
+      const vfloat c2_x = q_y * c1_z - q_z * c1_y;
+      const vfloat c2_y = q_z * c1_x - q_x * c1_z;
+      const vfloat c2_z = q_x * c1_y - q_y * c1_x;
+      const vfloat two_w = q_w * 2.0f;
+      out_x = v_x + c1_x * two_w + c2_x * 2.0f;
+      out_y = v_y + c1_y * two_w + c2_y * 2.0f;
+      out_z = v_z + c1_z * two_w + c2_z * 2.0f;
+    }
+
+    /// Lane-wise q = fromAxisAngle(omega / |omega|, |omega| dt) * q, renormalised; lanes with |omega| <= 1e-6 keep q
+    inline void integrateOrientation(vfloat ang_x, vfloat ang_y, vfloat ang_z, float dt, vfloat& q_w, vfloat& q_x, vfloat& q_y, vfloat& q_z)
+    {
+      const vfloat zero = splat<vfloat>(0.0f);
+      const vfloat one = splat<vfloat>(1.0f);
+      const vfloat speed = sqrtLanes(ang_x * ang_x + ang_y * ang_y + ang_z * ang_z);
+      const vint spinning = speed > 1e-6f;
+
+      vfloat sin_half = zero;
+      vfloat cos_half = one;
+      for(int lane = 0; lane < NATIVE_WIDTH; ++lane)
+      {
+        if(spinning[lane])
+        {
+          const float half_angle = speed[lane] * dt * 0.5f;
+          sin_half[lane] = std::sin(half_angle);
+          cos_half[lane] = std::cos(half_angle);
+        }
+      }
+      const vfloat scale = sin_half / select(spinning, speed, one);
+      const vfloat d_w = cos_half;
+      const vfloat d_x = ang_x * scale;
+      const vfloat d_y = ang_y * scale;
+      const vfloat d_z = ang_z * scale;
+
+      const vfloat w = d_w * q_w - d_x * q_x - d_y * q_y - d_z * q_z;
+      const vfloat x = d_w * q_x + d_x * q_w + d_y * q_z - d_z * q_y;
+      const vfloat y = d_w * q_y - d_x * q_z + d_y * q_w + d_z * q_x;
+      const vfloat z = d_w * q_z + d_x * q_y - d_y * q_x + d_z * q_w;
+      const vfloat inv_norm = one / sqrtLanes(w * w + x * x + y * y + z * z);
+
+      q_w = select(spinning, w * inv_norm, q_w);
+      q_x = select(spinning, x * inv_norm, q_x);
+      q_y = select(spinning, y * inv_norm, q_y);
+      q_z = select(spinning, z * inv_norm, q_z);
+    }
+  } // namespace
+
+  int SteelTargetWorld::addTarget(SteelTarget* target)
+  {
+    if(target == nullptr)
+    {
+      throw std::invalid_argument("SteelTargetWorld target must not be null");
+    }
+
+    int index;
+    if(!free_slots_.empty())
+    {
+      index = free_slots_.back();
+      free_slots_.pop_back();
+      targets_[index] = target;
+    }
+    else
+    {
+      index = static_cast<int>(targets_.size());
+      targets_.push_back(target);
+      is_awake_.push_back(0);
+    }
+    ++target_count_;
+
+    is_awake_[index] = 0;
+    if(target->isMoving())
+    {
+      is_awake_[index] = 1;
+      awake_.push_back(index);
+    }
+    return index;
+  }
+
+  void SteelTargetWorld::removeTarget(int index)
+  {
+    checkIndex(index);
+    if(is_awake_[index])
+    {
+      awake_.erase(std::find(awake_.begin(), awake_.end(), index));
+      is_awake_[index] = 0;
+    }
+    targets_[index] = nullptr;
+    free_slots_.push_back(index);
+    --target_count_;
+  }
+
+  void SteelTargetWorld::clear()
+  {
+    targets_.clear();
+    free_slots_.clear();
+    is_awake_.clear();
+    awake_.clear();
+    target_count_ = 0;
+  }
+
+  void SteelTargetWorld::wake(int index)
+  {
+    checkIndex(index);
+    SteelTarget& target = *targets_[index];
+    target.is_moving_ = true;
+    target.time_below_threshold_s_ = 0.0f;
+    if(!is_awake_[index])
+    {
+      is_awake_[index] = 1;
+      awake_.push_back(index);
+    }
+  }
+
+  void SteelTargetWorld::hit(int index, const btk::ballistics::Bullet& bullet)
+  {
+    checkIndex(index);
+    targets_[index]->hit(bullet);
+    wake(index);
+  }
+
+  int SteelTargetWorld::step(float dt)
+  {
+    BTK_PROFILE_SCOPE(STEEL_PHYSICS);
+
+    // Same clamping as SteelTarget::timeStep
+    dt = std::min(dt, 1.0f);
+    if(awake_.empty())
+    {
+      return 0;
+    }
+
+    gather();
+    stepBlocks(0, spring_block_count_, dt, SteelTarget::SPRING, spring_damping_);
+    stepBlocks(spring_block_count_, blocks_.size(), dt, SteelTarget::IMPLICIT, implicit_damping_);
+    scatter(dt);
+    return static_cast<int>(awake_.size());
+  }
+
+#ifdef __EMSCRIPTEN__
+  emscripten::val SteelTargetWorld::getAwakeIndices() const
+  {
+    using namespace emscripten;
+    if(awake_.empty())
+    {
+      return val::global("Int32Array").new_(0);
+    }
+    return val(typed_memory_view(awake_.size(), awake_.data()));
+  }
+#endif
+
+  void SteelTargetWorld::checkIndex(int index) const
+  {
+    if(index < 0 || index >= static_cast<int>(targets_.size()) || targets_[index] == nullptr)
+    {
+      throw std::invalid_argument("SteelTargetWorld target index out of range");
+    }
+  }
+
+  void SteelTargetWorld::gather()
+  {
+    // Lay out awake targets solver by solver so every block runs a single model
+    lane_targets_.clear();
+    for(SteelTarget::ChainSolver solver : {SteelTarget::SPRING, SteelTarget::IMPLICIT})
+    {
+      for(int32_t index : awake_)
+      {
+        if(targets_[index]->chain_solver_ == solver)
+        {
+          lane_targets_.push_back(index);
+        }
+      }
+      if(solver == SteelTarget::SPRING)
+      {
+        spring_block_count_ = (lane_targets_.size() + WIDTH - 1) / WIDTH;
+      }
+      lane_targets_.resize((lane_targets_.size() + WIDTH - 1) / WIDTH * WIDTH, -1);
+    }
+
+    const size_t block_count = lane_targets_.size() / WIDTH;
+    blocks_.assign(block_count, Block{});
+    anchor_blocks_.clear();
+
+    for(size_t b = 0; b < block_count; ++b)
+    {
+      Block& block = blocks_[b];
+
+      // Padding lanes: identity orientation and zero inverse mass, never written back
+      block.q_w = splat<vfloat>(1.0f);
+
+      size_t anchor_count = 0;
+      for(int lane = 0; lane < WIDTH; ++lane)
+      {
+        const int32_t index = lane_targets_[b * WIDTH + lane];
+        if(index >= 0)
+        {
+          anchor_count = std::max(anchor_count, targets_[index]->anchors_.size());
+        }
+      }
+      block.first_anchor = static_cast<uint32_t>(anchor_blocks_.size());
+      block.anchor_count = static_cast<uint32_t>(anchor_count);
+      anchor_blocks_.resize(anchor_blocks_.size() + anchor_count, AnchorBlock{});
+
+      for(int lane = 0; lane < WIDTH; ++lane)
+      {
+        const int32_t index = lane_targets_[b * WIDTH + lane];
+        if(index >= 0)
+        {
+          gatherLane(block, lane, *targets_[index]);
+        }
+      }
+    }
+  }
+
+  void SteelTargetWorld::gatherLane(Block& block, int lane, const SteelTarget& target)
+  {
+    block.pos_x[lane] = target.position_.x;
+    block.pos_y[lane] = target.position_.y;
+    block.pos_z[lane] = target.position_.z;
+    block.vel_x[lane] = target.velocity_ms_.x;
+    block.vel_y[lane] = target.velocity_ms_.y;
+    block.vel_z[lane] = target.velocity_ms_.z;
+    block.ang_x[lane] = target.angular_velocity_.x;
+    block.ang_y[lane] = target.angular_velocity_.y;
+    block.ang_z[lane] = target.angular_velocity_.z;
+    block.q_w[lane] = target.orientation_.w;
+    block.q_x[lane] = target.orientation_.x;
+    block.q_y[lane] = target.orientation_.y;
+    block.q_z[lane] = target.orientation_.z;
+    block.inv_mass[lane] = 1.0f / target.mass_kg_;
+    block.inv_inertia_x[lane] = 1.0f / target.inertia_tensor_.x;
+    block.inv_inertia_y[lane] = 1.0f / target.inertia_tensor_.y;
+    block.inv_inertia_z[lane] = 1.0f / target.inertia_tensor_.z;
+
+    for(size_t k = 0; k < target.anchors_.size(); ++k)
+    {
+      const SteelTarget::ChainAnchor& anchor = target.anchors_[k];
+      AnchorBlock& anchor_block = anchor_blocks_[block.first_anchor + k];
+      anchor_block.local_x[lane] = anchor.local_attachment_.x;
+      anchor_block.local_y[lane] = anchor.local_attachment_.y;
+      anchor_block.local_z[lane] = anchor.local_attachment_.z;
+      anchor_block.fixed_x[lane] = anchor.world_fixed_.x;
+      anchor_block.fixed_y[lane] = anchor.world_fixed_.y;
+      anchor_block.fixed_z[lane] = anchor.world_fixed_.z;
+      anchor_block.rest_length[lane] = anchor.rest_length_;
+      anchor_block.active[lane] = -1;
+    }
+  }
+
+  void SteelTargetWorld::scatter(float dt)
+  {
+    awake_.clear();
+    for(size_t i = 0; i < lane_targets_.size(); ++i)
+    {
+      const int32_t index = lane_targets_[i];
+      if(index < 0)
+      {
+        continue;
+      }
+
+      const Block& block = blocks_[i / WIDTH];
+      const int lane = static_cast<int>(i % WIDTH);
+      SteelTarget& target = *targets_[index];
+
+      target.position_ = btk::math::Vector3D(block.pos_x[lane], block.pos_y[lane], block.pos_z[lane]);
+      target.velocity_ms_ = btk::math::Vector3D(block.vel_x[lane], block.vel_y[lane], block.vel_z[lane]);
+      target.angular_velocity_ = btk::math::Vector3D(block.ang_x[lane], block.ang_y[lane], block.ang_z[lane]);
+      target.orientation_ = btk::math::Quaternion(block.q_w[lane], block.q_x[lane], block.q_y[lane], block.q_z[lane]);
+      target.normal_ = target.orientation_.rotate(btk::math::Vector3D(0.0f, 0.0f, -1.0f));
+
+      // Settle detection, as in SteelTarget::timeStep
+      if(target.velocity_ms_.magnitude() < SteelTarget::VELOCITY_THRESHOLD && target.angular_velocity_.magnitude() < SteelTarget::ANGULAR_VELOCITY_THRESHOLD)
+      {
+        target.time_below_threshold_s_ += dt;
+        if(target.time_below_threshold_s_ >= SteelTarget::SETTLE_TIME_THRESHOLD_S)
+        {
+          target.is_moving_ = false;
+        }
+      }
+      else
+      {
+        target.time_below_threshold_s_ = 0.0f;
+        target.is_moving_ = true;
+      }
+
+      if(target.is_moving_)
+      {
+        awake_.push_back(index);
+      }
+      else
+      {
+        is_awake_[index] = 0;
+      }
+    }
+  }
+
+  void SteelTargetWorld::stepBlocks(size_t first, size_t last, float dt, SteelTarget::ChainSolver solver, DampingFactors& damping)
+  {
+    for(size_t b = first; b < last; ++b)
+    {
+      Block& block = blocks_[b];
+
+      int num_substeps = static_cast<int>(std::ceil(dt / SteelTarget::MAX_SUBSTEP_DT));
+      if(solver == SteelTarget::IMPLICIT)
+      {
+        // One count per block, bounded by its fastest spin and lightest plate (padding lanes have zero inverse mass)
+        const vfloat angular_speed = sqrtLanes(block.ang_x * block.ang_x + block.ang_y * block.ang_y + block.ang_z * block.ang_z);
+        float max_angular_speed = 0.0f;
+        float max_inv_mass = 0.0f;
+        for(int lane = 0; lane < WIDTH; ++lane)
+        {
+          max_angular_speed = std::max(max_angular_speed, angular_speed[lane]);
+          max_inv_mass = std::max(max_inv_mass, block.inv_mass[lane]);
+        }
+        num_substeps = SteelTarget::implicitSubstepCount(dt, max_angular_speed, 1.0f / max_inv_mass);
+      }
+      if(num_substeps == 0)
+      {
+        continue;
+      }
+
+      const float substep_dt = dt / num_substeps;
+      if(substep_dt != damping.substep_dt)
+      {
+        // Frames usually repeat the same dt, so the pow() calls rarely run per block
+        damping.substep_dt = substep_dt;
+        damping.linear = std::pow(SteelTarget::LINEAR_DAMPING, substep_dt);
+        damping.angular = std::pow(SteelTarget::ANGULAR_DAMPING, substep_dt);
+      }
+
+      BTK_PROFILE_COUNT(STEEL_SUBSTEPS, num_substeps);
+      for(int i = 0; i < num_substeps; ++i)
+      {
+        if(solver == SteelTarget::IMPLICIT)
+        {
+          implicitSubstep(block, substep_dt, damping);
+        }
+        else
+        {
+          springSubstep(block, substep_dt, damping);
+        }
+      }
+    }
+  }
+
+  void SteelTargetWorld::springSubstep(Block& block, float dt, const DampingFactors& damping) const
+  {
+    const vfloat zero = splat<vfloat>(0.0f);
+    const vfloat one = splat<vfloat>(1.0f);
+
+    // Gravity at the centre of mass (BTK: Y is up)
+    block.vel_y -= splat<vfloat>(btk::physics::Constants::GRAVITY * dt);
+
+    // Chain tension, anchor by anchor like SteelTarget::applyChainForces
+    for(uint32_t k = 0; k < block.anchor_count; ++k)
+    {
+      const AnchorBlock& anchor = anchor_blocks_[block.first_anchor + k];
+
+      // Lever arm and world attachment point
+      vfloat r_x, r_y, r_z;
+      rotateLanes(block.q_w, block.q_x, block.q_y, block.q_z, anchor.local_x, anchor.local_y, anchor.local_z, r_x, r_y, r_z);
+      const vfloat attach_x = block.pos_x + r_x;
+      const vfloat attach_y = block.pos_y + r_y;
+      const vfloat attach_z = block.pos_z + r_z;
+
+      // Stretch beyond rest length (chains only pull)
+      const vfloat to_fixed_x = anchor.fixed_x - attach_x;
+      const vfloat to_fixed_y = anchor.fixed_y - attach_y;
+      const vfloat to_fixed_z = anchor.fixed_z - attach_z;
+      const vfloat distance = sqrtLanes(to_fixed_x * to_fixed_x + to_fixed_y * to_fixed_y + to_fixed_z * to_fixed_z);
+      const vfloat extension = distance - anchor.rest_length;
+      const vint taut = anchor.active & (distance >= 1e-6f) & (extension > zero);
+      const vfloat inv_distance = one / select(taut, distance, one);
+      const vfloat dir_x = to_fixed_x * inv_distance;
+      const vfloat dir_y = to_fixed_y * inv_distance;
+      const vfloat dir_z = to_fixed_z * inv_distance;
+
+      // Attachment velocity v + omega x r along the chain (positive = shortening)
+      const vfloat point_vel_x = block.vel_x + block.ang_y * r_z - block.ang_z * r_y;
+      const vfloat point_vel_y = block.vel_y + block.ang_z * r_x - block.ang_x * r_z;
+      const vfloat point_vel_z = block.vel_z + block.ang_x * r_y - block.ang_y * r_x;
+      const vfloat along = point_vel_x * dir_x + point_vel_y * dir_y + point_vel_z * dir_z;
+
+      // Spring plus damping of the rebound, as an impulse over dt
+      const vfloat chain_damping = select(along > zero, along * -SteelTarget::CHAIN_DAMPING, zero);
+      const vfloat magnitude = select(taut, (extension * SteelTarget::SPRING_CONSTANT + chain_damping) * dt, zero);
+      const vfloat impulse_x = dir_x * magnitude;
+      const vfloat impulse_y = dir_y * magnitude;
+      const vfloat impulse_z = dir_z * magnitude;
+
+      block.vel_x += impulse_x * block.inv_mass;
+      block.vel_y += impulse_y * block.inv_mass;
+      block.vel_z += impulse_z * block.inv_mass;
+
+      // Torque in local space (the local lever arm is the anchor's attachment point)
+      vfloat f_x, f_y, f_z;
+      rotateLanes(block.q_w, -block.q_x, -block.q_y, -block.q_z, impulse_x, impulse_y, impulse_z, f_x, f_y, f_z);
+      const vfloat acc_x = (anchor.local_y * f_z - anchor.local_z * f_y) * block.inv_inertia_x;
+      const vfloat acc_y = (anchor.local_z * f_x - anchor.local_x * f_z) * block.inv_inertia_y;
+      const vfloat acc_z = (anchor.local_x * f_y - anchor.local_y * f_x) * block.inv_inertia_z;
+      vfloat acc_world_x, acc_world_y, acc_world_z;
+      rotateLanes(block.q_w, block.q_x, block.q_y, block.q_z, acc_x, acc_y, acc_z, acc_world_x, acc_world_y, acc_world_z);
+      block.ang_x += acc_world_x;
+      block.ang_y += acc_world_y;
+      block.ang_z += acc_world_z;
+    }
+
+    // Damping factors precomputed per substep length
+    block.vel_x *= damping.linear;
+    block.vel_y *= damping.linear;
+    block.vel_z *= damping.linear;
+    block.ang_x *= damping.angular;
+    block.ang_y *= damping.angular;
+    block.ang_z *= damping.angular;
+
+    // Semi-implicit Euler
+    block.pos_x += block.vel_x * dt;
+    block.pos_y += block.vel_y * dt;
+    block.pos_z += block.vel_z * dt;
+    integrateOrientation(block.ang_x, block.ang_y, block.ang_z, dt, block.q_w, block.q_x, block.q_y, block.q_z);
+  }
+
+  void SteelTargetWorld::implicitSubstep(Block& block, float dt, const DampingFactors& damping) const
+  {
+    const vfloat zero = splat<vfloat>(0.0f);
+    const vfloat one = splat<vfloat>(1.0f);
+
+    block.vel_y -= splat<vfloat>(btk::physics::Constants::GRAVITY * dt);
+
+    // Backward-Euler chain impulses, anchor by anchor like SteelTarget::implicitSubstep
+    for(uint32_t k = 0; k < block.anchor_count; ++k)
+    {
+      const AnchorBlock& anchor = anchor_blocks_[block.first_anchor + k];
+
+      vfloat r_x, r_y, r_z;
+      rotateLanes(block.q_w, block.q_x, block.q_y, block.q_z, anchor.local_x, anchor.local_y, anchor.local_z, r_x, r_y, r_z);
+      const vfloat stretch_x = (block.pos_x - anchor.fixed_x) + r_x;
+      const vfloat stretch_y = (block.pos_y - anchor.fixed_y) + r_y;
+      const vfloat stretch_z = (block.pos_z - anchor.fixed_z) + r_z;
+      const vfloat distance = sqrtLanes(stretch_x * stretch_x + stretch_y * stretch_y + stretch_z * stretch_z);
+      const vfloat extension = distance - anchor.rest_length;
+      const vint taut = anchor.active & (distance >= 1e-6f) & (extension > zero);
+      const vfloat inv_distance = one / select(taut, distance, one);
+      const vfloat n_x = stretch_x * inv_distance;
+      const vfloat n_y = stretch_y * inv_distance;
+      const vfloat n_z = stretch_z * inv_distance;
+
+      // Inverse mass along the chain (local space, diagonal inertia)
+      vfloat nl_x, nl_y, nl_z;
+      rotateLanes(block.q_w, -block.q_x, -block.q_y, -block.q_z, n_x, n_y, n_z, nl_x, nl_y, nl_z);
+      const vfloat rn_x = anchor.local_y * nl_z - anchor.local_z * nl_y;
+      const vfloat rn_y = anchor.local_z * nl_x - anchor.local_x * nl_z;
+      const vfloat rn_z = anchor.local_x * nl_y - anchor.local_y * nl_x;
+      const vfloat inverse_mass = block.inv_mass + rn_x * rn_x * block.inv_inertia_x + rn_y * rn_y * block.inv_inertia_y + rn_z * rn_z * block.inv_inertia_z;
+
+      // Attachment speed away from the fixed point; damping acts while the chain shortens
+      const vfloat speed = (block.vel_x + block.ang_y * r_z - block.ang_z * r_y) * n_x + (block.vel_y + block.ang_z * r_x - block.ang_x * r_z) * n_y +
+                           (block.vel_z + block.ang_x * r_y - block.ang_y * r_x) * n_z;
+      const vfloat stiffness = SteelTarget::SPRING_CONSTANT * dt + select(speed < zero, splat<vfloat>(SteelTarget::CHAIN_DAMPING), zero);
+      const vfloat impulse = select(taut, -dt * (extension * SteelTarget::SPRING_CONSTANT + stiffness * speed) / (one + dt * inverse_mass * stiffness), zero);
+
+      block.vel_x += n_x * impulse * block.inv_mass;
+      block.vel_y += n_y * impulse * block.inv_mass;
+      block.vel_z += n_z * impulse * block.inv_mass;
+
+      vfloat acc_x, acc_y, acc_z;
+      rotateLanes(block.q_w, block.q_x, block.q_y, block.q_z, rn_x * block.inv_inertia_x * impulse, rn_y * block.inv_inertia_y * impulse, rn_z * block.inv_inertia_z * impulse, acc_x, acc_y,
+                  acc_z);
+      block.ang_x += acc_x;
+      block.ang_y += acc_y;
+      block.ang_z += acc_z;
+    }
+
+    block.vel_x *= damping.linear;
+    block.vel_y *= damping.linear;
+    block.vel_z *= damping.linear;
+    block.ang_x *= damping.angular;
+    block.ang_y *= damping.angular;
+    block.ang_z *= damping.angular;
+
+    // Semi-implicit Euler
+    block.pos_x += block.vel_x * dt;
+    block.pos_y += block.vel_y * dt;
+    block.pos_z += block.vel_z * dt;
+    integrateOrientation(block.ang_x, block.ang_y, block.ang_z, dt, block.q_w, block.q_x, block.q_y, block.q_z);
+  }
+
+} // namespace btk::rendering
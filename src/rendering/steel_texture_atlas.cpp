@@ -0,0 +1,209 @@
+#include "rendering/steel_texture_atlas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace btk::rendering
+{
+
+  SteelTextureAtlas::SteelTextureAtlas(int page_size) : page_size_(page_size)
+  {
+    if(page_size <= 0)
+    {
+      throw std::invalid_argument("SteelTextureAtlas page size must be positive");
+    }
+  }
+
+  int SteelTextureAtlas::addTarget(SteelTarget* target, int texture_size)
+  {
+    if(target == nullptr)
+    {
+      throw std::invalid_argument("SteelTextureAtlas target must not be null");
+    }
+    if(texture_size <= 0 || texture_size * 2 > page_size_)
+    {
+      throw std::invalid_argument("SteelTextureAtlas texture size does not fit on a page");
+    }
+
+    const Region region = allocate(texture_size * 2, texture_size);
+
+    int index;
+    if(!free_slots_.empty())
+    {
+      index = free_slots_.back();
+      free_slots_.pop_back();
+      targets_[index] = target;
+      regions_[index] = region;
+    }
+    else
+    {
+      index = static_cast<int>(targets_.size());
+      targets_.push_back(target);
+      regions_.push_back(region);
+    }
+    ++target_count_;
+
+    target->bindTextureStorage(regionOrigin(region), static_cast<size_t>(page_size_) * 4, texture_size);
+    return index;
+  }
+
+  void SteelTextureAtlas::removeTarget(int index)
+  {
+    checkIndex(index);
+    targets_[index]->unbindTextureStorage();
+    free_regions_.push_back(regions_[index]);
+    targets_[index] = nullptr;
+    free_slots_.push_back(index);
+    --target_count_;
+  }
+
+  void SteelTextureAtlas::clear()
+  {
+    for(SteelTarget* target : targets_)
+    {
+      if(target != nullptr)
+      {
+        target->unbindTextureStorage();
+      }
+    }
+    targets_.clear();
+    regions_.clear();
+    free_slots_.clear();
+    target_count_ = 0;
+    std::vector<uint8_t>().swap(texels_);
+    page_count_ = 0;
+    page_next_y_.clear();
+    shelves_.clear();
+    free_regions_.clear();
+  }
+
+  SteelTextureAtlas::Region SteelTextureAtlas::getRegion(int index) const
+  {
+    checkIndex(index);
+    return regions_[index];
+  }
+
+  SteelTextureAtlas::UVRect SteelTextureAtlas::getUVRect(int index) const
+  {
+    checkIndex(index);
+    const Region& region = regions_[index];
+    const float inv_size = 1.0f / static_cast<float>(page_size_);
+    UVRect rect;
+    rect.u_ = region.x_ * inv_size;
+    rect.v_ = region.y_ * inv_size;
+    rect.width_ = region.width_ * inv_size;
+    rect.height_ = region.height_ * inv_size;
+    return rect;
+  }
+
+#ifdef __EMSCRIPTEN__
+  emscripten::val SteelTextureAtlas::getTexels() const
+  {
+    using namespace emscripten;
+    if(texels_.empty())
+    {
+      return val::global("Uint8Array").new_(0);
+    }
+    return val(typed_memory_view(texels_.size(), texels_.data()));
+  }
+
+  emscripten::val SteelTextureAtlas::getPageRows(int page, int y, int height) const
+  {
+    using namespace emscripten;
+    if(page < 0 || page >= page_count_)
+    {
+      throw std::invalid_argument("SteelTextureAtlas page index out of range");
+    }
+    if(y < 0 || height < 0 || y + height > page_size_)
+    {
+      throw std::invalid_argument("SteelTextureAtlas row range out of range");
+    }
+    const size_t row_bytes = static_cast<size_t>(page_size_) * 4;
+    const size_t offset = (static_cast<size_t>(page) * page_size_ + y) * row_bytes;
+    return val(typed_memory_view(static_cast<size_t>(height) * row_bytes, texels_.data() + offset));
+  }
+#endif
+
+  void SteelTextureAtlas::checkIndex(int index) const
+  {
+    if(index < 0 || index >= static_cast<int>(targets_.size()) || targets_[index] == nullptr)
+    {
+      throw std::invalid_argument("SteelTextureAtlas target index out of range");
+    }
+  }
+
+  SteelTextureAtlas::Region SteelTextureAtlas::allocate(int width, int height)
+  {
+    // Exact-size region left by a removed target
+    for(size_t i = 0; i < free_regions_.size(); ++i)
+    {
+      if(free_regions_[i].width_ == width && free_regions_[i].height_ == height)
+      {
+        const Region region = free_regions_[i];
+        free_regions_[i] = free_regions_.back();
+        free_regions_.pop_back();
+        return region;
+      }
+    }
+
+    // Lowest shelf that is tall enough and has room
+    Shelf* best = nullptr;
+    for(Shelf& shelf : shelves_)
+    {
+      if(shelf.height >= height && page_size_ - shelf.next_x >= width && (best == nullptr || shelf.height < best->height))
+      {
+        best = &shelf;
+      }
+    }
+
+    // Otherwise open a new shelf, on a new page if none has room
+    if(best == nullptr)
+    {
+      int page = 0;
+      while(page < page_count_ && page_size_ - page_next_y_[page] < height)
+      {
+        ++page;
+      }
+      if(page == page_count_)
+      {
+        addPage();
+      }
+      shelves_.push_back(Shelf{page, page_next_y_[page], height, 0});
+      page_next_y_[page] += height;
+      best = &shelves_.back();
+    }
+
+    Region region;
+    region.page_ = best->page;
+    region.x_ = best->next_x;
+    region.y_ = best->y;
+    region.width_ = width;
+    region.height_ = height;
+    best->next_x += width;
+    return region;
+  }
+
+  uint8_t* SteelTextureAtlas::regionOrigin(const Region& region)
+  {
+    const size_t row_bytes = static_cast<size_t>(page_size_) * 4;
+    return texels_.data() + (static_cast<size_t>(region.page_) * page_size_ + region.y_) * row_bytes + static_cast<size_t>(region.x_) * 4;
+  }
+
+  void SteelTextureAtlas::addPage()
+  {
+    ++page_count_;
+    texels_.resize(static_cast<size_t>(page_count_) * page_size_ * page_size_ * 4, 0);
+    page_next_y_.push_back(0);
+
+    // The buffer may have moved; point registered targets at their regions again (texels were copied)
+    for(size_t i = 0; i < targets_.size(); ++i)
+    {
+      if(targets_[i] != nullptr)
+      {
+        targets_[i]->shared_texture_data_ = regionOrigin(regions_[i]);
+      }
+    }
+  }
+
+} // namespace btk::rendering
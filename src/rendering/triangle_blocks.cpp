@@ -0,0 +1,118 @@
+#include "rendering/triangle_blocks.h"
+#include "profiling/profiler.h"
+
+namespace btk::rendering
+{
+
+  using namespace btk::math::simd;
+
+  void TriangleBlocks::bake(const std::vector<btk::math::Vector3D>& vertices, const std::vector<uint32_t>& indices, const std::vector<Range>& ranges)
+  {
+    size_t block_count = 0;
+    for(const Range& range : ranges)
+    {
+      block_count += (range.count + WIDTH - 1) / WIDTH;
+    }
+    blocks_.assign(block_count, Block{});
+    range_block_.assign(indices.size() / 3, 0);
+
+    uint32_t block_index = 0;
+    for(const Range& range : ranges)
+    {
+      range_block_[range.first] = block_index;
+      for(uint32_t k = 0; k < range.count; ++k)
+      {
+        const uint32_t i = range.first + k;
+        const btk::math::Vector3D& v0 = vertices[indices[i * 3]];
+        const btk::math::Vector3D e1 = vertices[indices[i * 3 + 1]] - v0;
+        const btk::math::Vector3D e2 = vertices[indices[i * 3 + 2]] - v0;
+
+        Block& block = blocks_[block_index + k / WIDTH];
+        const int lane = static_cast<int>(k % WIDTH);
+        block.v0_x[lane] = v0.x;
+        block.v0_y[lane] = v0.y;
+        block.v0_z[lane] = v0.z;
+        block.e1_x[lane] = e1.x;
+        block.e1_y[lane] = e1.y;
+        block.e1_z[lane] = e1.z;
+        block.e2_x[lane] = e2.x;
+        block.e2_y[lane] = e2.y;
+        block.e2_z[lane] = e2.z;
+      }
+      block_index += (range.count + WIDTH - 1) / WIDTH;
+    }
+  }
+
+  bool TriangleBlocks::intersect(const btk::math::Vector3D& origin, const btk::math::Vector3D& dir, uint32_t first, uint32_t count, float& t_max, uint32_t& hit_triangle) const
+  {
+    constexpr float EPSILON = 1e-6f; // Same parallel threshold as the scalar Möller–Trumbore test
+
+    const vfloat o_x = splat<vfloat>(origin.x);
+    const vfloat o_y = splat<vfloat>(origin.y);
+    const vfloat o_z = splat<vfloat>(origin.z);
+    const vfloat d_x = splat<vfloat>(dir.x);
+    const vfloat d_y = splat<vfloat>(dir.y);
+    const vfloat d_z = splat<vfloat>(dir.z);
+    const vfloat zero = splat<vfloat>(0.0f);
+    const vfloat one = splat<vfloat>(1.0f);
+
+    bool hit = false;
+    const uint32_t first_block = range_block_[first];
+    const uint32_t block_count = (count + WIDTH - 1) / WIDTH;
+    BTK_PROFILE_COUNT(TRIANGLE_TESTS, count);
+    for(uint32_t b = 0; b < block_count; ++b)
+    {
+      const Block& block = blocks_[first_block + b];
+
+      // h = dir x e2, a = e1 . h
+      const vfloat h_x = d_y * block.e2_z - d_z * block.e2_y;
+      const vfloat h_y = d_z * block.e2_x - d_x * block.e2_z;
+      const vfloat h_z = d_x * block.e2_y - d_y * block.e2_x;
+      const vfloat a = block.e1_x * h_x + block.e1_y * h_y + block.e1_z * h_z;
+
+      // Lanes not parallel to the segment (padding lanes are degenerate)
+      vint valid = (a > EPSILON) | (a < -EPSILON);
+      const vfloat f = select(valid, one / a, zero);
+
+      // s = origin - v0, u = f * (s . h)
+      const vfloat s_x = o_x - block.v0_x;
+      const vfloat s_y = o_y - block.v0_y;
+      const vfloat s_z = o_z - block.v0_z;
+      const vfloat u = f * (s_x * h_x + s_y * h_y + s_z * h_z);
+
+      // q = s x e1, v = f * (dir . q), t = f * (e2 . q)
+      const vfloat q_x = s_y * block.e1_z - s_z * block.e1_y;
+      const vfloat q_y = s_z * block.e1_x - s_x * block.e1_z;
+      const vfloat q_z = s_x * block.e1_y - s_y * block.e1_x;
+      const vfloat v = f * (d_x * q_x + d_y * q_y + d_z * q_z);
+      const vfloat t = f * (block.e2_x * q_x + block.e2_y * q_y + block.e2_z * q_z);
+
+      valid &= (u >= zero) & (u <= one) & (v >= zero) & (u + v <= one) & (t >= zero) & (t <= one);
+
+      // Most blocks miss entirely; only then look at individual lanes
+      int32_t any_valid = 0;
+      for(int lane = 0; lane < WIDTH; ++lane)
+      {
+        any_valid |= valid[lane];
+      }
+      if(any_valid == 0)
+      {
+        continue;
+      }
+
+      // Nearest lane; ties keep the lower triangle like the scalar loop
+      for(int lane = 0; lane < WIDTH; ++lane)
+      {
+        if(valid[lane] && t[lane] < t_max)
+        {
+          t_max = t[lane];
+          hit_triangle = first + b * WIDTH + static_cast<uint32_t>(lane);
+          hit = true;
+        }
+      }
+    }
+
+    return hit;
+  }
+
+} // namespace btk::rendering
@@ -0,0 +1,536 @@
+// Benchmarks of the engine's hot paths.
+//
+// Every case reseeds btk::math::Random with its own fixed seed before setup, so
+// scenes, wind fields and Monte Carlo draws are identical from run to run and
+// build to build; the checksum of each case changes only when results do.
+// Results are written as JSON (stdout, or --out) for tracking regressions.
+//
+//   btk_bench [--filter <substring>] [--repetitions <n>] [--out <file>] [--list]
+
+#include "ballistics/bullet.h"
+#include "ballistics/performance_matrix.h"
+#include "ballistics/simulator.h"
+#include "ballistics/trajectory.h"
+#include "match/simulator.h"
+#include "match/targets.h"
+#include "math/conversions.h"
+#include "math/random.h"
+#include "math/simd.h"
+#include "math/vector.h"
+#include "physics/atmosphere.h"
+#include "physics/wind_generator.h"
+#include "rendering/impact_detector.h"
+#include "rendering/steel_target.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace btk;
+
+namespace
+{
+  /// Timed loop body: runs one iteration and returns a value folded into the case checksum
+  using Body = std::function<double()>;
+
+  struct BenchCase
+  {
+    std::string name;
+    std::string description;
+    uint32_t seed;
+    int iterations;              ///< Timed iterations per repetition
+    std::function<Body()> setup; ///< Builds the scene (untimed) and returns the timed body
+  };
+
+  struct BenchResult
+  {
+    const BenchCase* bench;
+    std::vector<double> ns_per_iteration; ///< One entry per repetition
+    double checksum;
+  };
+
+  // Shared scene parameters: 6.5 mm 140 gr G7 bullet, 2700 fps, 8 in twist, 100 yd zero
+  const ballistics::Bullet BULLET(math::Conversions::grainsToKg(140.0f), math::Conversions::inchesToMeters(0.264f), math::Conversions::inchesToMeters(1.35f), 0.305f);
+  const float MUZZLE_VELOCITY = math::Conversions::fpsToMps(2700.0f);
+  const float TWIST = math::Conversions::inchesToMeters(8.0f);
+  const float ZERO_RANGE = math::Conversions::yardsToMeters(100.0f);
+  const float SCOPE_HEIGHT = 0.05f;
+  const float DT = 0.001f;
+
+  /// Simulator zeroed at ZERO_RANGE in still air (BTK coordinates: x right, y up, -z downrange)
+  std::unique_ptr<ballistics::Simulator> makeZeroedSimulator()
+  {
+    auto simulator = std::make_unique<ballistics::Simulator>();
+    simulator->setInitialBullet(BULLET);
+    simulator->setAtmosphere(physics::Atmosphere::standard());
+    simulator->setWind(math::Vector3D(0.0f, 0.0f, 0.0f));
+    simulator->computeZero(MUZZLE_VELOCITY, math::Vector3D(0.0f, SCOPE_HEIGHT, -ZERO_RANGE), DT, 20, 0.001f, ballistics::Bullet::computeSpinRateFromTwist(MUZZLE_VELOCITY, TWIST));
+    return simulator;
+  }
+
+  /// Wind preset covering a range out to range_m
+  physics::WindGenerator makeWind(float range_m)
+  {
+    return physics::WindPresets::getPreset("Moderate", math::Vector3D(-50.0f, 0.0f, 10.0f), math::Vector3D(50.0f, 20.0f, -range_m - 10.0f));
+  }
+
+  /// Hanging plate with two chains, as placed by the steel simulator
+  std::unique_ptr<rendering::SteelTarget> makeHangingPlate(const math::Vector3D& position, float width, float height, bool oval, int texture_size)
+  {
+    auto target = std::make_unique<rendering::SteelTarget>(width, height, 0.0095f, oval, position, math::Vector3D(0.0f, 0.0f, -1.0f), texture_size);
+    const float attach_x = width * 0.35f;
+    const float attach_y = height * 0.5f;
+    const float beam_height = position.y + attach_y + 0.3f;
+    for(float side : {-1.0f, 1.0f})
+    {
+      const math::Vector3D local(side * attach_x, attach_y, -0.00475f);
+      const math::Vector3D world = target->localToWorld(local);
+      target->addChainAnchor(local, math::Vector3D(world.x + side * 0.05f, beam_height, world.z));
+    }
+    return target;
+  }
+
+  /// Bullet at a point on a plate's front face, travelling downrange
+  ballistics::Bullet bulletAt(const rendering::SteelTarget& target, float u, float v, float speed)
+  {
+    const math::Vector3D dimensions = target.getDimensions();
+    const math::Vector3D point = target.localToWorld(math::Vector3D(u * dimensions.x * 0.5f, v * dimensions.y * 0.5f, 0.0f));
+    return ballistics::Bullet(BULLET, point, math::Vector3D(0.0f, 0.0f, -speed), 0.0f);
+  }
+
+  /// Fire the zeroed bullet from the origin turned by small yaw (right) and pitch (up) angles
+  const ballistics::Trajectory& simulateAimed(ballistics::Simulator& simulator, const ballistics::Bullet& zeroed, float yaw_rad, float pitch_rad, float range_m)
+  {
+    const math::Vector3D v = zeroed.getVelocity();
+    const math::Vector3D aimed(v.x - v.z * yaw_rad, v.y - v.z * pitch_rad, v.z);
+    simulator.setInitialBullet(ballistics::Bullet(zeroed, math::Vector3D(0.0f, 0.0f, 0.0f), aimed, zeroed.getSpinRate()));
+    simulator.simulate(range_m, DT, 60.0f);
+    return simulator.getTrajectory();
+  }
+
+  /// Checksum term for an impact search result
+  double impactChecksum(const std::optional<rendering::ImpactResult>& impact) { return impact ? impact->object_id + impact->time_s : -1.0; }
+
+  std::vector<BenchCase> makeCases()
+  {
+    std::vector<BenchCase> cases;
+
+    for(float range_yd : {300.0f, 1000.0f, 1760.0f})
+    {
+      const float range_m = math::Conversions::yardsToMeters(range_yd);
+      const std::string yd = std::to_string(static_cast<int>(range_yd));
+      const int iterations = range_yd > 1000.0f ? 50 : 100;
+
+      cases.push_back({"trajectory_" + yd + "yd", "Simulator::simulate to " + yd + " yd in still air", 1, iterations, [range_m]() -> Body
+                       {
+                         auto simulator = std::shared_ptr<ballistics::Simulator>(makeZeroedSimulator());
+                         return [simulator, range_m]()
+                         {
+                           simulator->resetToInitial();
+                           simulator->simulate(range_m, DT, 60.0f);
+                           return static_cast<double>(simulator->getCurrentBullet().getPositionY());
+                         };
+                       }});
+
+      cases.push_back({"trajectory_" + yd + "yd_wind", "Simulator::simulate to " + yd + " yd through a WindGenerator", 2, iterations, [range_m]() -> Body
+                       {
+                         auto simulator = std::shared_ptr<ballistics::Simulator>(makeZeroedSimulator());
+                         auto wind = std::make_shared<physics::WindGenerator>(makeWind(range_m));
+                         return [simulator, wind, range_m]()
+                         {
+                           simulator->resetToInitial();
+                           simulator->simulate(range_m, DT, 60.0f, *wind);
+                           return static_cast<double>(simulator->getCurrentBullet().getPositionX());
+                         };
+                       }});
+    }
+
+    cases.push_back({"compute_zero", "Simulator::computeZero at 100 yd with spin", 3, 20, []() -> Body
+                     {
+                       auto simulator = std::make_shared<ballistics::Simulator>();
+                       simulator->setAtmosphere(physics::Atmosphere::standard());
+                       simulator->setWind(math::Vector3D(0.0f, 0.0f, 0.0f));
+                       const float spin = ballistics::Bullet::computeSpinRateFromTwist(MUZZLE_VELOCITY, TWIST);
+                       return [simulator, spin]()
+                       {
+                         simulator->setInitialBullet(BULLET);
+                         const ballistics::Bullet& zeroed = simulator->computeZero(MUZZLE_VELOCITY, math::Vector3D(0.0f, SCOPE_HEIGHT, -ZERO_RANGE), DT, 20, 0.001f, spin);
+                         return static_cast<double>(zeroed.getVelocityY());
+                       };
+                     }});
+
+    cases.push_back({"performance_matrix_10x10", "PerformanceMatrix::compute, 10 BCs x 10 MVs at 1000 yd on one thread", 3, 1, []() -> Body
+                     {
+                       auto matrix = std::make_shared<ballistics::PerformanceMatrix>(BULLET, physics::Atmosphere::standard(), math::Conversions::yardsToMeters(1000.0f),
+                                                                                     math::Conversions::mphToMps(10.0f), 0.002f);
+                       std::vector<float> bcs;
+                       std::vector<float> mvs;
+                       for(int i = 0; i < 10; ++i)
+                       {
+                         bcs.push_back(0.25f + 0.02f * i);
+                         mvs.push_back(math::Conversions::fpsToMps(2500.0f + 50.0f * i));
+                       }
+                       return [matrix, bcs, mvs]()
+                       {
+                         matrix->compute(bcs.data(), bcs.size(), mvs.data(), mvs.size(), 1);
+                         double sum = 0.0;
+                         for(float value : matrix->getSensitivity())
+                         {
+                           sum += value;
+                         }
+                         return sum;
+                       };
+                     }});
+
+    cases.push_back({"match_fire_shot_10k", "match::Simulator::fireShot Monte Carlo, 10000 shots at 600 yd", 4, 10000, []() -> Body
+                     {
+                       auto simulator = std::make_shared<match::Simulator>(BULLET, MUZZLE_VELOCITY, match::Targets::getTarget("MR-1"), math::Conversions::yardsToMeters(600.0f),
+                                                                           physics::Atmosphere::standard(), 3.0f, 1.0f, 0.5f, 0.2f, 0.0003f, DT, TWIST);
+                       return [simulator]()
+                       {
+                         return static_cast<double>(simulator->fireShot().score);
+                       };
+                     }});
+
+    cases.push_back({"wind_sample", "WindGenerator::sample at scattered points (ns per sample)", 5, 1000000, []() -> Body
+                     {
+                       const float range_m = math::Conversions::yardsToMeters(1000.0f);
+                       auto wind = std::make_shared<physics::WindGenerator>(makeWind(range_m));
+                       wind->advanceTime(10.0f);
+                       auto points = std::make_shared<std::vector<math::Vector3D>>();
+                       for(int i = 0; i < 4096; ++i)
+                       {
+                         points->emplace_back(math::Random::uniform(-50.0f, 50.0f), math::Random::uniform(0.0f, 20.0f), -math::Random::uniform(0.0f, range_m));
+                       }
+                       auto next = std::make_shared<size_t>(0);
+                       return [wind, points, next]()
+                       {
+                         const math::Vector3D& p = (*points)[(*next)++ & 4095];
+                         return static_cast<double>(wind->sample(p.x, p.y, p.z).x);
+                       };
+                     }});
+
+    cases.push_back({"impact_steel_rack", "ImpactDetector::findFirstImpact, 50 hanging plates from 100 to 1000 yd", 6, 1000, []() -> Body
+                     {
+                       struct Scene
+                       {
+                         std::vector<std::unique_ptr<rendering::SteelTarget>> targets;
+                         std::unique_ptr<rendering::ImpactDetector> detector;
+                         std::vector<ballistics::Trajectory> volley;
+                         size_t next = 0;
+                       };
+                       auto scene = std::make_shared<Scene>();
+                       const float range_m = math::Conversions::yardsToMeters(1000.0f);
+                       scene->detector = std::make_unique<rendering::ImpactDetector>(10.0f, -50.0f, 50.0f, -range_m - 20.0f, 20.0f);
+                       auto simulator = makeZeroedSimulator();
+                       const ballistics::Bullet zeroed = simulator->getInitialBullet();
+                       const ballistics::Trajectory nominal = simulateAimed(*simulator, zeroed, 0.0f, 0.0f, range_m);
+
+                       // One rack of five plates every 100 yd, staggered sideways and hung at the bullet's height there
+                       std::vector<math::Vector3D> aim_points;
+                       for(int rack = 1; rack <= 10; ++rack)
+                       {
+                         const float distance = math::Conversions::yardsToMeters(100.0f * rack);
+                         const float height = nominal.getPositionAtDistance(distance)->y;
+                         for(int plate = 0; plate < 5; ++plate)
+                         {
+                           const float size = 0.15f + 0.05f * plate;
+                           const math::Vector3D position((rack - 5.5f) * 4.0f + (plate - 2) * 0.6f, height, -distance);
+                           scene->targets.push_back(makeHangingPlate(position, size, size, plate % 2 == 0, 64));
+                           scene->detector->addSteelCollider(scene->targets.back().get(), size, rack * 10 + plate);
+                           aim_points.push_back(position);
+                         }
+                       }
+
+                       // Shots at random plates with 1 mrad of dispersion; some miss, some stop on a nearer rack
+                       for(int i = 0; i < 64; ++i)
+                       {
+                         const math::Vector3D& aim = aim_points[math::Random::uniformInt(0, static_cast<int>(aim_points.size()) - 1)];
+                         const float yaw = aim.x / -aim.z + math::Random::normal(0.0f, 0.001f);
+                         const float pitch = math::Random::normal(0.0f, 0.001f);
+                         scene->volley.push_back(simulateAimed(*simulator, zeroed, yaw, pitch, range_m));
+                       }
+                       return [scene]()
+                       {
+                         const ballistics::Trajectory& trajectory = scene->volley[scene->next++ % scene->volley.size()];
+                         return impactChecksum(scene->detector->findFirstImpact(trajectory, 0.0f, trajectory.getTotalTime()));
+                       };
+                     }});
+
+    cases.push_back({"impact_dense_mesh", "ImpactDetector::findFirstImpact against 400k terrain triangles", 7, 1000, []() -> Body
+                     {
+                       struct Scene
+                       {
+                         std::unique_ptr<rendering::ImpactDetector> detector;
+                         std::vector<ballistics::Trajectory> volley;
+                         size_t next = 0;
+                       };
+                       auto scene = std::make_shared<Scene>();
+                       constexpr int TILE_QUADS = 50; // 1 m quads, 50 x 50 m tiles
+                       scene->detector = std::make_unique<rendering::ImpactDetector>(10.0f, -100.0f, 100.0f, -1000.0f, 0.0f);
+
+                       // Rolling terrain a little below the bore, 4 x 20 tiles
+                       for(int tile_x = 0; tile_x < 4; ++tile_x)
+                       {
+                         for(int tile_z = 0; tile_z < 20; ++tile_z)
+                         {
+                           std::vector<float> vertices;
+                           std::vector<uint32_t> indices;
+                           vertices.reserve((TILE_QUADS + 1) * (TILE_QUADS + 1) * 3);
+                           indices.reserve(TILE_QUADS * TILE_QUADS * 6);
+                           for(int j = 0; j <= TILE_QUADS; ++j)
+                           {
+                             for(int i = 0; i <= TILE_QUADS; ++i)
+                             {
+                               const float x = -100.0f + tile_x * TILE_QUADS + i;
+                               const float z = -static_cast<float>(tile_z * TILE_QUADS + j);
+                               vertices.push_back(x);
+                               vertices.push_back(-1.5f + 0.5f * std::sin(x * 0.13f) * std::cos(z * 0.07f) + math::Random::uniform(-0.05f, 0.05f));
+                               vertices.push_back(z);
+                             }
+                           }
+                           for(uint32_t j = 0; j < TILE_QUADS; ++j)
+                           {
+                             for(uint32_t i = 0; i < TILE_QUADS; ++i)
+                             {
+                               const uint32_t a = j * (TILE_QUADS + 1) + i;
+                               const uint32_t b = a + TILE_QUADS + 1;
+                               indices.insert(indices.end(), {a, b, a + 1, a + 1, b, b + 1});
+                             }
+                           }
+                           scene->detector->addMeshCollider(vertices, indices, tile_x * 100 + tile_z);
+                         }
+                       }
+
+                       // Aimed low so shots land on the terrain between 200 and 900 m
+                       auto simulator = makeZeroedSimulator();
+                       const ballistics::Bullet zeroed = simulator->getInitialBullet();
+                       for(int i = 0; i < 64; ++i)
+                       {
+                         const float landing = math::Random::uniform(200.0f, 900.0f);
+                         const float yaw = math::Random::uniform(-0.05f, 0.05f);
+                         scene->volley.push_back(simulateAimed(*simulator, zeroed, yaw, -1.5f / landing, 1000.0f));
+                       }
+                       return [scene]()
+                       {
+                         const ballistics::Trajectory& trajectory = scene->volley[scene->next++ % scene->volley.size()];
+                         return impactChecksum(scene->detector->findFirstImpact(trajectory, 0.0f, trajectory.getTotalTime()));
+                       };
+                     }});
+
+    cases.push_back({"steel_time_step", "SteelTarget::timeStep at 60 Hz on a swinging chain-hung plate", 8, 20000, []() -> Body
+                     {
+                       std::shared_ptr<rendering::SteelTarget> target = makeHangingPlate(math::Vector3D(0.0f, 1.0f, -100.0f), 0.3f, 0.3f, false, 64);
+                       target->setTextureEnabled(false);
+                       return [target]()
+                       {
+                         if(!target->isMoving())
+                         {
+                           target->hit(bulletAt(*target, 0.5f, -0.5f, 700.0f));
+                         }
+                         target->timeStep(1.0f / 60.0f);
+                         return static_cast<double>(target->getCenterOfMass().z);
+                       };
+                     }});
+
+    // Impact painting; drawing is part of SteelTarget::hit (see also steel_hit_no_texture)
+    for(int texture_size : {256, 1024})
+    {
+      const std::string size = std::to_string(texture_size);
+      cases.push_back({"steel_hit_texture_" + size, "SteelTarget::hit drawing impact marks into a " + size + " texture", 9, 2000, [texture_size]() -> Body
+                       {
+                         std::shared_ptr<rendering::SteelTarget> target = makeHangingPlate(math::Vector3D(0.0f, 1.0f, -100.0f), 0.3f, 0.3f, false, texture_size);
+                         target->initializeTexture();
+                         return [target]()
+                         {
+                           target->clearDirtyRect();
+                           target->hit(bulletAt(*target, math::Random::uniform(-0.9f, 0.9f), math::Random::uniform(-0.9f, 0.9f), 700.0f));
+                           return static_cast<double>(target->getDirtyRect().width_);
+                         };
+                       }});
+    }
+
+    cases.push_back({"steel_hit_no_texture", "SteelTarget::hit with the texture disabled (decal list only)", 9, 2000, []() -> Body
+                     {
+                       std::shared_ptr<rendering::SteelTarget> target = makeHangingPlate(math::Vector3D(0.0f, 1.0f, -100.0f), 0.3f, 0.3f, false, 256);
+                       target->setTextureEnabled(false);
+                       return [target]()
+                       {
+                         target->hit(bulletAt(*target, math::Random::uniform(-0.9f, 0.9f), math::Random::uniform(-0.9f, 0.9f), 700.0f));
+                         return static_cast<double>(target->getDecalCount());
+                       };
+                     }});
+
+    return cases;
+  }
+
+  BenchResult run(const BenchCase& bench, int repetitions)
+  {
+    BenchResult result{&bench, {}, 0.0};
+    for(int rep = 0; rep < repetitions; ++rep)
+    {
+      // Same seed every repetition, so each one times identical work
+      math::Random::seed(bench.seed);
+      Body body = bench.setup();
+
+      double checksum = 0.0;
+      const auto start = std::chrono::steady_clock::now();
+      for(int i = 0; i < bench.iterations; ++i)
+      {
+        checksum += body();
+      }
+      const auto end = std::chrono::steady_clock::now();
+
+      result.ns_per_iteration.push_back(std::chrono::duration<double, std::nano>(end - start).count() / bench.iterations);
+      result.checksum = checksum;
+    }
+    return result;
+  }
+
+  std::string jsonEscape(const std::string& text)
+  {
+    std::string out;
+    for(char c : text)
+    {
+      if(c == '"' || c == '\\')
+      {
+        out += '\\';
+      }
+      out += c;
+    }
+    return out;
+  }
+
+  void writeJson(std::ostream& out, const std::vector<BenchResult>& results, int repetitions)
+  {
+    out << std::setprecision(10);
+    out << "{\n";
+    out << "  \"benchmark\": \"btk_bench\",\n";
+#ifdef __VERSION__
+    out << "  \"compiler\": \"" << jsonEscape(__VERSION__) << "\",\n";
+#endif
+    out << "  \"simd_width\": " << math::simd::NATIVE_WIDTH << ",\n";
+    out << "  \"repetitions\": " << repetitions << ",\n";
+    out << "  \"cases\": [";
+    for(size_t i = 0; i < results.size(); ++i)
+    {
+      const BenchResult& result = results[i];
+      std::vector<double> sorted = result.ns_per_iteration;
+      std::sort(sorted.begin(), sorted.end());
+      double mean = 0.0;
+      for(double ns : sorted)
+      {
+        mean += ns;
+      }
+      mean /= sorted.size();
+      double variance = 0.0;
+      for(double ns : sorted)
+      {
+        variance += (ns - mean) * (ns - mean);
+      }
+      const double stddev = sorted.size() > 1 ? std::sqrt(variance / (sorted.size() - 1)) : 0.0;
+      const size_t mid = sorted.size() / 2;
+      const double median = sorted.size() % 2 ? sorted[mid] : 0.5 * (sorted[mid - 1] + sorted[mid]);
+
+      out << (i ? ",\n" : "\n");
+      out << "    {\n";
+      out << "      \"name\": \"" << jsonEscape(result.bench->name) << "\",\n";
+      out << "      \"description\": \"" << jsonEscape(result.bench->description) << "\",\n";
+      out << "      \"seed\": " << result.bench->seed << ",\n";
+      out << "      \"iterations\": " << result.bench->iterations << ",\n";
+      out << "      \"ns_per_iteration\": {\"min\": " << sorted.front() << ", \"median\": " << median << ", \"mean\": " << mean << ", \"max\": " << sorted.back() << ", \"stddev\": " << stddev << "},\n";
+      out << "      \"checksum\": " << result.checksum << "\n";
+      out << "    }";
+    }
+    out << "\n  ]\n}\n";
+  }
+
+  void printUsage()
+  {
+    std::cerr << "Usage: btk_bench [--filter <substring>] [--repetitions <n>] [--out <file>] [--list]" << std::endl;
+  }
+} // namespace
+
+int main(int argc, char** argv)
+{
+  std::string filter;
+  std::string out_path;
+  int repetitions = 5;
+  bool list = false;
+
+  for(int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if(arg == "--filter" && i + 1 < argc)
+    {
+      filter = argv[++i];
+    }
+    else if(arg == "--repetitions" && i + 1 < argc)
+    {
+      repetitions = std::max(1, std::atoi(argv[++i]));
+    }
+    else if(arg == "--out" && i + 1 < argc)
+    {
+      out_path = argv[++i];
+    }
+    else if(arg == "--list")
+    {
+      list = true;
+    }
+    else
+    {
+      printUsage();
+      return 1;
+    }
+  }
+
+  const std::vector<BenchCase> cases = makeCases();
+  std::vector<BenchResult> results;
+  for(const BenchCase& bench : cases)
+  {
+    if(!filter.empty() && bench.name.find(filter) == std::string::npos)
+    {
+      continue;
+    }
+    if(list)
+    {
+      std::cout << bench.name << "  " << bench.description << std::endl;
+      continue;
+    }
+
+    std::cerr << bench.name << "... " << std::flush;
+    results.push_back(run(bench, repetitions));
+    std::vector<double> sorted = results.back().ns_per_iteration;
+    std::sort(sorted.begin(), sorted.end());
+    std::cerr << std::fixed << std::setprecision(1) << sorted.front() / 1000.0 << " us/iter (min)" << std::endl;
+  }
+  if(list)
+  {
+    return 0;
+  }
+
+  if(out_path.empty())
+  {
+    writeJson(std::cout, results, repetitions);
+  }
+  else
+  {
+    std::ofstream file(out_path);
+    if(!file.is_open())
+    {
+      std::cerr << "Failed to open file: " << out_path << std::endl;
+      return 1;
+    }
+    writeJson(file, results, repetitions);
+  }
+  return 0;
+}
@@ -8,7 +8,7 @@ mkdir -p build
 cd build
 
 # Configure and build
-cmake .. -DCMAKE_BUILD_TYPE=Release
+cmake .. -DCMAKE_BUILD_TYPE=Release -DBTK_NATIVE_ARCH=ON
 cmake --build .
 
 echo ""
@@ -160,7 +160,8 @@ std::pair<float, float> computePredictedDeltas(const Observation& obs, float lif
   simulator.setWind(zero_wind);
   
   float target_range_m = btk::math::Conversions::yardsToMeters(obs.range_yd);
-  ballistics::Trajectory traj_zero = simulator.simulate(target_range_m, 0.001f, 60.0f);
+  simulator.simulate(target_range_m, 0.001f, 60.0f);
+  const ballistics::Trajectory& traj_zero = simulator.getTrajectory();
   std::optional<ballistics::TrajectoryPoint> point_zero = traj_zero.atDistance(target_range_m);
   
   if (!point_zero.has_value())
@@ -185,7 +186,8 @@ std::pair<float, float> computePredictedDeltas(const Observation& obs, float lif
   math::Vector3D crosswind(0.0f, wind_mps, 0.0f); // Positive Y = from right
   
   simulator.setWind(crosswind);
-  ballistics::Trajectory traj_wind = simulator.simulate(target_range_m, 0.001f, 60.0f);
+  simulator.simulate(target_range_m, 0.001f, 60.0f);
+  const ballistics::Trajectory& traj_wind = simulator.getTrajectory();
   std::optional<ballistics::TrajectoryPoint> point_wind = traj_wind.atDistance(target_range_m);
   
   if (!point_wind.has_value())
@@ -1,4 +1,4 @@
-import BallisticsToolkit from '../ballistics_toolkit_wasm.js';
+import BallisticsToolkit from '../btk-loader.js';
 
 let btk = null;
 
@@ -81,28 +81,6 @@ function calculateTrajectory()
   // Create atmosphere
   const atmosphere = new btk.Atmosphere(temperature, altitude, humidity, 0.0);
 
-  // Create simulator
-  const simulator = new btk.BallisticsSimulator();
-  simulator.setInitialBullet(bullet);
-  simulator.setAtmosphere(atmosphere);
-
-  // Compute zero with no wind
-  const zeroWind = new btk.Vector3D(0, 0, 0);
-  simulator.setWind(zeroWind);
-  zeroWind.delete(); // Dispose Vector3D to prevent memory leak
-
-  // Create target position vector (x=crossrange, y=vertical, z=-downrange)
-  const targetPos = new btk.Vector3D(0, scopeHeight, -zeroRange);
-  simulator.computeZero(
-    muzzleVelocity,
-    targetPos,
-    0.001, // dt (time step)
-    20, // max_iterations
-    0.001, // tolerance
-    spinRate // spin_rate calculated from twist
-  );
-  targetPos.delete(); // Dispose Vector3D to prevent memory leak
-
   // Wind vector in BTK coordinate system: X=crossrange (right), Y=up, Z=-downrange.
   // With the convention above and θ = -φ:
   //  - 12 o'clock (from target)  → headwind (+Z, against bullet flight)
@@ -113,49 +91,37 @@ function calculateTrajectory()
   const windY = 0.0; // No vertical component
   const windZ = windSpeed * Math.cos(windDirection); // Downrange component (+Z = headwind from target, −Z = tailwind from behind)
 
+  // Zero in still air and build the table at the specified intervals (one native pass per run)
   const windVector = new btk.Vector3D(windX, windY, windZ);
-  simulator.setWind(windVector);
+  const rangeTable = new btk.RangeTable(
+    bullet,
+    muzzleVelocity,
+    zeroRange,
+    scopeHeight,
+    atmosphere,
+    windVector,
+    spinRate,
+    btk.RangeTableAngleUnit.MRAD,
+    0.001 // dt (time step)
+  );
   windVector.delete(); // Dispose Vector3D to prevent memory leak
+  rangeTable.build(maxRange, step);
 
-  // Simulate trajectory (trajectory is owned by simulator, get reference to it)
-  simulator.simulate(maxRange, 0.001, 60.0);
-  const trajectoryObj = simulator.getTrajectory();
+  const rows = rangeTable.getData();
+  const stride = btk.RangeTable.STRIDE;
 
-  // Extract trajectory points at specified intervals
   const trajectory = [];
-
-  for (let range = 0; range <= maxRange; range += step)
+  for (let offset = 0; offset < rows.length; offset += stride)
   {
-    const point = trajectoryObj.atDistance(range);
-    if (!point)
-    {
-      console.warn(`Failed to get trajectory point at range ${range}m`);
-      continue;
-    }
-    const state = point.getState();
-    const position = state.getPosition();
-
-    // Calculate drop relative to scope height
-    // In new coordinate system: X=crossrange, Y=up, Z=-downrange
-    const bulletHeight = position.y; // Vertical component is now Y
-    const dropMeters = bulletHeight - scopeHeight;
-    const dropMrad = range > 0 ? (dropMeters / range) * 1000 : 0;
-
-    // Calculate drift (crosswind component)
-    const driftMeters = position.x; // Crossrange component is now X
-    const driftMrad = range > 0 ? (driftMeters / range) * 1000 : 0;
-
     trajectory.push(
     {
-      range: btk.Conversions.metersToYards(range),
-      drop: dropMrad,
-      drift: driftMrad,
-      velocity: btk.Conversions.mpsToFps(state.getTotalVelocity()),
-      energy: point.getKineticEnergy(),
-      time: point.getTime()
+      range: btk.Conversions.metersToYards(rows[offset + btk.RangeTable.FIELD_RANGE]),
+      drop: rows[offset + btk.RangeTable.FIELD_DROP_ANGLE],
+      drift: rows[offset + btk.RangeTable.FIELD_WINDAGE_ANGLE],
+      velocity: btk.Conversions.mpsToFps(rows[offset + btk.RangeTable.FIELD_VELOCITY]),
+      energy: rows[offset + btk.RangeTable.FIELD_ENERGY],
+      time: rows[offset + btk.RangeTable.FIELD_TIME]
     });
-
-    point.delete(); // Dispose TrajectoryPoint to prevent memory leak
   }
 
   // Get atmospheric data before deleting the atmosphere object
@@ -204,8 +170,7 @@ function calculateTrajectory()
   displayResults(trajectory, airDensity, pressure, speedOfSound, tempKelvin, sectionalDensity, spinRateRpm, enableSpinEffects, millerStabilityFactor, idealTwistRate, twistRateInches, inputParams);
 
   // Dispose BTK objects to prevent memory leaks
-  // Note: trajectoryObj is owned by simulator, don't delete it
-  simulator.delete();
+  rangeTable.delete();
   atmosphere.delete();
   bullet.delete();
 }
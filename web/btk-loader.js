@@ -0,0 +1,101 @@
+/**
+ * btk-loader - Loads the fastest BallisticsToolkit WebAssembly build the browser supports
+ *
+ * Three builds of the same engine are deployed next to this file:
+ *   ballistics_toolkit_wasm.js          baseline (runs everywhere)
+ *   ballistics_toolkit_wasm_simd.js     SIMD128
+ *   ballistics_toolkit_wasm_simd_mt.js  SIMD128 + pthreads (needs SharedArrayBuffer,
+ *                                       i.e. a cross-origin isolated page; see _headers)
+ *
+ * The default export is a drop-in replacement for the Emscripten factory:
+ *   const btk = await BallisticsToolkit();
+ * btk.btkVariant names the build that was loaded. Adding ?btk=baseline|simd|simd_mt
+ * to the page URL forces a build (for comparing them).
+ */
+
+// (func (result v128) i32.const 0 i8x16.splat i8x16.popcnt)
+const SIMD_PROBE = new Uint8Array([0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0, 10, 10, 1, 8, 0, 65, 0, 253, 15, 253, 98, 11]);
+
+const VARIANTS = {
+  baseline: () => import('./ballistics_toolkit_wasm.js'),
+  simd: () => import('./ballistics_toolkit_wasm_simd.js'),
+  simd_mt: () => import('./ballistics_toolkit_wasm_simd_mt.js')
+};
+
+/**
+ * Check whether the browser validates WebAssembly SIMD128
+ * @returns {boolean}
+ */
+export function hasWasmSimd()
+{
+  try
+  {
+    return typeof WebAssembly === 'object' && WebAssembly.validate(SIMD_PROBE);
+  }
+  catch (e)
+  {
+    return false;
+  }
+}
+
+/**
+ * Check whether WebAssembly threads can run (SharedArrayBuffer on a cross-origin isolated page)
+ * @returns {boolean}
+ */
+export function hasWasmThreads()
+{
+  return typeof SharedArrayBuffer !== 'undefined' && globalThis.crossOriginIsolated === true;
+}
+
+/**
+ * Pick the build to load
+ * @returns {string} 'simd_mt', 'simd' or 'baseline'
+ */
+export function selectVariant()
+{
+  if (typeof location !== 'undefined')
+  {
+    const forced = new URLSearchParams(location.search).get('btk');
+    if (forced && forced in VARIANTS)
+    {
+      return forced;
+    }
+  }
+
+  if (!hasWasmSimd())
+  {
+    return 'baseline';
+  }
+  return hasWasmThreads() ? 'simd_mt' : 'simd';
+}
+
+/**
+ * Instantiate the selected build, falling back to the baseline if it cannot be loaded
+ * @param {Object} [moduleArg] - Emscripten module overrides, passed to the factory
+ * @returns {Promise<Object>} BTK module
+ */
+export default async function BallisticsToolkit(moduleArg = {})
+{
+  let variant = selectVariant();
+  let module;
+  try
+  {
+    const factory = (await VARIANTS[variant]()).default;
+    module = await factory(moduleArg);
+  }
+  catch (e)
+  {
+    if (variant === 'baseline')
+    {
+      throw e;
+    }
+    console.warn(`[BTK] ${variant} build failed to load, using baseline:`, e);
+    variant = 'baseline';
+    const factory = (await VARIANTS.baseline()).default;
+    module = await factory(moduleArg);
+  }
+
+  module.btkVariant = variant;
+  console.info(`[BTK] Using the ${variant} build`);
+  return module;
+}
@@ -1,4 +1,4 @@
-import BallisticsToolkit from '../../ballistics_toolkit_wasm.js';
+import BallisticsToolkit from '../../btk-loader.js';
 
 // Load BTK module at module level (promise-based, non-blocking)
 let btk = null;
@@ -12,8 +12,7 @@ import
 from '../core/virtual-coords.js';
 import
 {
-  getBTK,
-  sampleWindAtThreeJsPosition
+  getBTK
 }
 from '../core/btk.js';
 
@@ -195,22 +194,30 @@ export class WindFieldHUD
     const startX = this.hudX - this.hudWidth / 2; // Left edge of HUD
     const startY = this.hudY - this.hudHeight / 2; // Bottom edge of HUD
 
+    // Rasterise the whole grid natively in one call (rows = downrange from shooter, cols = crossrange)
+    // Three.js/BTK: X=right, Y=up, Z=towards-camera (negative Z = downrange)
+    const minCorner = new btk.Vector3D(
+      btk.Conversions.yardsToMeters(-this.rangeWidth / 2),
+      btk.Conversions.yardsToMeters(this.targetHeight),
+      0);
+    const maxCorner = new btk.Vector3D(
+      btk.Conversions.yardsToMeters(this.rangeWidth / 2),
+      btk.Conversions.yardsToMeters(this.targetHeight),
+      btk.Conversions.yardsToMeters(-this.targetDistance));
+    this.windGenerator.updateFieldTexture(this.cols, this.rows, minCorner, maxCorner);
+    minCorner.delete();
+    maxCorner.delete();
+    const field = this.windGenerator.getFieldTexture(); // RG = (crosswind, -headwind) m/s
+    const mpsToMph = btk.Conversions.mpsToMph(1.0);
+
     for (let idx = 0; idx < this.count; idx++)
     {
-      const pos = this.gridPositions[idx];
-
-      // Grid positions stored as:
-      // pos.x = downrange distance (0 to targetDistance yards)
-      // pos.y = crossrange position (-rangeWidth/2 to +rangeWidth/2 yards)
-
-      // Convert to Three.js coordinates for wind sampling:
-      // Three.js: X=right, Y=up, Z=towards-camera (negative Z = downrange)
-      const x_threeJs = pos.y; // Crossrange position (left-right)
-      const y_threeJs = this.targetHeight; // Height (vertical)
-      const z_threeJs = -pos.x; // Downrange position (negative because downrange is -Z)
-
-      // Sample wind at this position (returns wind in mph, Three.js coords)
-      const wind = sampleWindAtThreeJsPosition(this.windGenerator, x_threeJs, y_threeJs, z_threeJs);
+      // Field texel idx matches grid index (row-major, same cell centers as gridPositions)
+      const wind = {
+        x: field[idx * 2 + 0] * mpsToMph,
+        y: 0,
+        z: field[idx * 2 + 1] * mpsToMph
+      };
 
       // Calculate wind speed and direction
       // wind.x = crosswind (positive = right)
@@ -1,4 +1,4 @@
-import BallisticsToolkit from '../ballistics_toolkit_wasm.js';
+import BallisticsToolkit from '../btk-loader.js';
 
 let btk = null;
 
@@ -90,47 +90,45 @@ function simulateBullet(params, maxRangeYards)
   simulator.simulate(maxRangeMeters, 0.001, 60.0);
   const trajectoryObj = simulator.getTrajectory();
 
-  // Extract trajectory points at 100-yard intervals
-  const results = [];
+  // Sample the trajectory at 100-yard intervals in one call
+  const rangesYards = [];
+  const rangesMeters = [];
   for (let rangeYards = 0; rangeYards <= maxRangeYards; rangeYards += STEP_YARDS)
   {
-    const rangeMeters = btk.Conversions.yardsToMeters(rangeYards);
-    const point = trajectoryObj.atDistance(rangeMeters);
-
-    if (!point)
-    {
-      console.warn(`Failed to get trajectory point at ${rangeYards} yards`);
-      continue;
-    }
+    rangesYards.push(rangeYards);
+    rangesMeters.push(btk.Conversions.yardsToMeters(rangeYards));
+  }
+  const samples = trajectoryObj.sampleAtDistances(rangesMeters);
+  const stride = btk.Trajectory.SAMPLE_STRIDE;
 
-    const state = point.getState();
-    const position = state.getPosition();
+  const results = [];
+  for (let i = 0; i < rangesYards.length; i++)
+  {
+    const offset = i * stride;
 
     // Drop: vertical position (Y component) - negative means below muzzle
-    const dropMeters = position.y;
+    const dropMeters = samples[offset + btk.Trajectory.SAMPLE_Y];
     const dropInches = btk.Conversions.metersToInches(dropMeters);
 
     // Drift: crossrange position (X component)
-    const driftMeters = position.x;
+    const driftMeters = samples[offset + btk.Trajectory.SAMPLE_X];
     const driftInches = btk.Conversions.metersToInches(driftMeters);
 
     // Velocity and energy
-    const velocityMps = state.getTotalVelocity();
+    const velocityMps = samples[offset + btk.Trajectory.SAMPLE_VELOCITY];
     const velocityFps = btk.Conversions.mpsToFps(velocityMps);
-    const energyJoules = point.getKineticEnergy();
+    const energyJoules = samples[offset + btk.Trajectory.SAMPLE_ENERGY];
     const energyFtLbs = btk.Conversions.joulesToFootPounds(energyJoules);
 
     results.push(
     {
-      range: rangeYards,
+      range: rangesYards[i],
       drop: dropInches,
       velocity: velocityFps,
       energy: energyFtLbs,
       drift: driftInches,
-      time: point.getTime()
+      time: samples[offset + btk.Trajectory.SAMPLE_TIME]
     });
-
-    point.delete();
   }
 
   // Clean up BTK objects
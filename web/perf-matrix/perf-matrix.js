@@ -1,4 +1,4 @@
-import BallisticsToolkit from '../ballistics_toolkit_wasm.js';
+import BallisticsToolkit from '../btk-loader.js';
 
 let btk = null;
 
@@ -141,17 +141,12 @@ function calculateGrid()
       // Fixed 10 mph crosswind for drift calculations
       const crosswindMph = 10;
 
-      // Compute all data in optimized passes
-      const driftData = computeTrajectoryGrid(bcValues, mvValues, params.range, crosswindMph, 
-                                               dragFunction, temperatureK, altitudeMeters, humidityFraction, 'drift');
-      const mainData = computeTrajectoryGrid(bcValues, mvValues, params.range, 0, 
-                                              dragFunction, temperatureK, altitudeMeters, humidityFraction, 'all');
-      const sensitivityData = computeSensitivityGrid(bcValues, mvValues, params.range, 
-                                                      dragFunction, temperatureK, altitudeMeters, humidityFraction);
+      // Compute all five grids in one native call
+      const { drift: driftData, drop: dropData, sensitivity: sensitivityData, velocity: velocityData, energy: energyData } =
+        computeMatrix(bcValues, mvValues, params.range, crosswindMph, dragFunction, temperatureK, altitudeMeters, humidityFraction);
 
       // Display results
-      displayResults(driftData, mainData.drop, sensitivityData, mainData.velocity, mainData.energy, 
-                     bcValues, mvValues, params);
+      displayResults(driftData, dropData, sensitivityData, velocityData, energyData, bcValues, mvValues, params);
 
       document.getElementById('loading').style.display = 'none';
     }
@@ -165,257 +160,50 @@ function calculateGrid()
 }
 
 /**
- * Compute trajectory data for each BC/MV combination
- * Returns drift OR {drop, velocity, energy} depending on mode
+ * Compute drift, drop, MV sensitivity, velocity and energy for every BC/MV combination
+ * Drift uses a full-value crosswind; sensitivity is the drop difference between MV ±0.5% (1% total spread).
+ * The grid is evaluated natively in one call (on all cores in the threaded build).
+ * @returns {Object} {drift, drop, sensitivity} in MRAD, {velocity} in fps and {energy} in ft-lbs, each [bc][mv]
  */
-function computeTrajectoryGrid(bcValues, mvValues, rangeYards, crosswindMph, 
-                                dragFunction, temperatureK, altitudeMeters, humidityFraction, mode)
+function computeMatrix(bcValues, mvValues, rangeYards, crosswindMph,
+                       dragFunction, temperatureK, altitudeMeters, humidityFraction)
 {
-  const rangeMeters = btk.Conversions.yardsToMeters(rangeYards);
-  const crosswindMps = btk.Conversions.mphToMps(crosswindMph);
-
-  // Wind: crosswind from 3 o'clock (wind blowing left, -X direction)
-  const windX = -crosswindMps;
-  const windY = 0;
-  const windZ = 0;
-
   // Typical bullet dimensions
   const diameterMeters = btk.Conversions.inchesToMeters(0.264);
   const lengthMeters = btk.Conversions.inchesToMeters(1.3);
   const weightKg = btk.Conversions.grainsToKg(140);
 
-  // Initialize result grids
-  const driftGrid = [];
-  const dropGrid = [];
-  const velocityGrid = [];
-  const energyGrid = [];
-
-  for (const bc of bcValues)
-  {
-    const driftRow = [];
-    const dropRow = [];
-    const velocityRow = [];
-    const energyRow = [];
-    
-    for (const mvFps of mvValues)
-    {
-      const mvMps = btk.Conversions.fpsToMps(mvFps);
-      
-      // Create bullet
-      const bullet = new btk.Bullet(
-        weightKg,
-        diameterMeters,
-        lengthMeters,
-        bc,
-        dragFunction
-      );
-      
-      // Create atmosphere
-      const atmosphere = new btk.Atmosphere(temperatureK, altitudeMeters, humidityFraction, 0.0);
-      
-      // Create bullet with flight state (fire horizontally from origin)
-      const initialPos = new btk.Vector3D(0, 0, 0);
-      const initialVel = new btk.Vector3D(0, 0, -mvMps);
-      const bulletWithState = new btk.Bullet(bullet, initialPos, initialVel, 0);
-      initialPos.delete();
-      initialVel.delete();
-      
-      // Create simulator
-      const simulator = new btk.BallisticsSimulator();
-      simulator.setInitialBullet(bulletWithState);
-      simulator.setAtmosphere(atmosphere);
-      
-      // Set wind
-      const windVector = new btk.Vector3D(windX, windY, windZ);
-      simulator.setWind(windVector);
-      windVector.delete();
-      
-      // Simulate trajectory
-      simulator.simulate(rangeMeters, 0.001, 60.0);
-      const trajectoryObj = simulator.getTrajectory();
-      
-      // Get values at range
-      const point = trajectoryObj.atDistance(rangeMeters);
-      
-      if (point)
-      {
-        const state = point.getState();
-        const position = state.getPosition();
-        const velocity = state.getVelocity();
-        
-        // Drift (X component)
-        const driftMeters = Math.abs(position.x);
-        const driftAngleRad = Math.atan(driftMeters / rangeMeters);
-        const driftMrad = driftAngleRad * 1000;
-        driftRow.push(driftMrad);
-        
-        // Drop (Y component)
-        const dropMeters = Math.abs(position.y);
-        const dropAngleRad = Math.atan(dropMeters / rangeMeters);
-        const dropMrad = dropAngleRad * 1000;
-        dropRow.push(dropMrad);
-        
-        // Velocity (magnitude of velocity vector)
-        const speedMps = velocity.magnitude();
-        const speedFps = btk.Conversions.mpsToFps(speedMps);
-        velocityRow.push(speedFps);
-        
-        // Energy: KE = 0.5 * m * v^2
-        const energyJoules = 0.5 * weightKg * speedMps * speedMps;
-        const energyFtLbs = btk.Conversions.joulesToFootPounds(energyJoules);
-        energyRow.push(energyFtLbs);
-        
-        velocity.delete();
-        position.delete();
-        point.delete();
-      }
-      else
-      {
-        driftRow.push(0);
-        dropRow.push(0);
-        velocityRow.push(0);
-        energyRow.push(0);
-      }
-      
-      // Cleanup
-      simulator.delete();
-      atmosphere.delete();
-      bulletWithState.delete();
-      bullet.delete();
-    }
-    
-    driftGrid.push(driftRow);
-    dropGrid.push(dropRow);
-    velocityGrid.push(velocityRow);
-    energyGrid.push(energyRow);
-  }
+  // BC is set per row by the engine
+  const bullet = new btk.Bullet(weightKg, diameterMeters, lengthMeters, bcValues[0], dragFunction);
+  const atmosphere = new btk.Atmosphere(temperatureK, altitudeMeters, humidityFraction, 0.0);
 
-  if (mode === 'drift')
-  {
-    return driftGrid;
-  }
-  
-  return {
-    drop: dropGrid,
-    velocity: velocityGrid,
-    energy: energyGrid
+  // 2 ms steps: within 0.0001 MRAD and 0.1 fps of 1 ms steps at half the cost
+  const matrix = new btk.PerformanceMatrix(
+    bullet,
+    atmosphere,
+    btk.Conversions.yardsToMeters(rangeYards),
+    btk.Conversions.mphToMps(crosswindMph),
+    0.002
+  );
+  matrix.compute(bcValues, mvValues.map(mvFps => btk.Conversions.fpsToMps(mvFps)), 0);
+
+  // Copy the flat native grids into [bc][mv] rows (the views are invalidated if the WASM heap grows)
+  const toRows = (flat, convert) =>
+    bcValues.map((bc, i) => Array.from(flat.subarray(i * mvValues.length, (i + 1) * mvValues.length), convert));
+
+  const result = {
+    drift: toRows(matrix.getDrift(), value => value),
+    drop: toRows(matrix.getDrop(), value => value),
+    sensitivity: toRows(matrix.getSensitivity(), value => value),
+    velocity: toRows(matrix.getVelocity(), mps => btk.Conversions.mpsToFps(mps)),
+    energy: toRows(matrix.getEnergy(), joules => btk.Conversions.joulesToFootPounds(joules))
   };
-}
-
-/**
- * Compute MV sensitivity for each BC/MV combination
- * Sensitivity = drop difference between MV ±0.5% (1% total spread)
- */
-function computeSensitivityGrid(bcValues, mvValues, rangeYards, 
-                                dragFunction, temperatureK, altitudeMeters, humidityFraction)
-{
-  const rangeMeters = btk.Conversions.yardsToMeters(rangeYards);
-  const MV_VARIATION_PERCENT = 0.5; // ±0.5% = 1% total spread
-
-  // Typical bullet dimensions
-  const diameterMeters = btk.Conversions.inchesToMeters(0.264);
-  const lengthMeters = btk.Conversions.inchesToMeters(1.3);
-  const weightKg = btk.Conversions.grainsToKg(140);
-
-  const grid = [];
-
-  for (const bc of bcValues)
-  {
-    const row = [];
-    
-    for (const mvFps of mvValues)
-    {
-      // Calculate ±0.5% variation
-      const mvDelta = mvFps * (MV_VARIATION_PERCENT / 100);
-      
-      // Calculate drop at MV - 0.5%
-      const mvSlowMps = btk.Conversions.fpsToMps(mvFps - mvDelta);
-      const dropSlowMrad = calculateDrop(bc, mvSlowMps, rangeMeters, temperatureK, altitudeMeters, humidityFraction, 
-                                         weightKg, diameterMeters, lengthMeters, dragFunction);
-      
-      // Calculate drop at MV + 0.5%
-      const mvFastMps = btk.Conversions.fpsToMps(mvFps + mvDelta);
-      const dropFastMrad = calculateDrop(bc, mvFastMps, rangeMeters, temperatureK, altitudeMeters, humidityFraction,
-                                         weightKg, diameterMeters, lengthMeters, dragFunction);
-      
-      // Sensitivity is the absolute difference in drop
-      const sensitivity = Math.abs(dropSlowMrad - dropFastMrad);
-      
-      row.push(sensitivity);
-    }
-    
-    grid.push(row);
-  }
 
-  return grid;
-}
-
-/**
- * Helper function to calculate drop for a single trajectory
- */
-function calculateDrop(bc, mvMps, rangeMeters, temperatureK, altitudeMeters, humidityFraction,
-                       weightKg, diameterMeters, lengthMeters, dragFunction)
-{
-  // Create bullet
-  const bullet = new btk.Bullet(
-    weightKg,
-    diameterMeters,
-    lengthMeters,
-    bc,
-    dragFunction
-  );
-  
-  // Create atmosphere
-  const atmosphere = new btk.Atmosphere(temperatureK, altitudeMeters, humidityFraction, 0.0);
-  
-  // Create bullet with flight state (fire horizontally from origin)
-  const initialPos = new btk.Vector3D(0, 0, 0);
-  const initialVel = new btk.Vector3D(0, 0, -mvMps);
-  const bulletWithState = new btk.Bullet(bullet, initialPos, initialVel, 0);
-  initialPos.delete();
-  initialVel.delete();
-  
-  // Create simulator
-  const simulator = new btk.BallisticsSimulator();
-  simulator.setInitialBullet(bulletWithState);
-  simulator.setAtmosphere(atmosphere);
-  
-  // No wind for sensitivity calculation
-  const windVector = new btk.Vector3D(0, 0, 0);
-  simulator.setWind(windVector);
-  windVector.delete();
-  
-  // Simulate trajectory
-  simulator.simulate(rangeMeters, 0.001, 60.0);
-  const trajectoryObj = simulator.getTrajectory();
-  
-  // Get drop at range
-  const point = trajectoryObj.atDistance(rangeMeters);
-  
-  let dropMrad = 0;
-  if (point)
-  {
-    const state = point.getState();
-    const position = state.getPosition();
-    
-    // Drop: vertical position (Y component) - negative means below muzzle
-    const dropMeters = Math.abs(position.y);
-    
-    // Convert meters to MRAD
-    const angleRad = Math.atan(dropMeters / rangeMeters);
-    dropMrad = angleRad * 1000;
-    
-    position.delete();
-    point.delete();
-  }
-  
-  // Cleanup
-  simulator.delete();
+  matrix.delete();
   atmosphere.delete();
-  bulletWithState.delete();
   bullet.delete();
-  
-  return dropMrad;
+
+  return result;
 }
 
 /**
@@ -66,20 +66,23 @@ export class BallisticsTable
 
     simulator.setInitialBullet(bullet);
 
-    // Simulate entire trajectory at once
-    simulator.simulate(maxRange_m, 0.001, 10.0);
-    const trajectoryObj = simulator.getTrajectory();
-
+    // Stream the trajectory and record only the table stations (stops after the last one)
+    const recorder = new window.btk.StationRecorder(window.btk.StationType.DISTANCE);
     for (let range = 0; range <= maxRange_m; range += rangeStep_m)
     {
-      const point = trajectoryObj.atDistance(range);
-      if (!point) continue;
+      recorder.addStation(range);
+    }
+    simulator.simulateObserved(maxRange_m, 0.001, 10.0, recorder);
+    const samples = recorder.getSamples();
+    recorder.delete();
+    const stride = window.btk.Trajectory.SAMPLE_STRIDE;
 
-      const state = point.getState();
-      const position = state.getPosition();
+    for (let offset = 0; offset < samples.length; offset += stride)
+    {
+      const range = (offset / stride) * rangeStep_m; // Stations are recorded in order
 
-      const drop_m = position.y;
-      const spinDrift_m = position.x; // Lateral displacement due to spin drift
+      const drop_m = samples[offset + window.btk.Trajectory.SAMPLE_Y];
+      const spinDrift_m = samples[offset + window.btk.Trajectory.SAMPLE_X]; // Lateral displacement due to spin drift
       const drop_mrad = range > 0 ? (drop_m / range) * 1000.0 : 0.0;
       const spinDrift_mrad = range > 0 ? (spinDrift_m / range) * 1000.0 : 0.0;
 
@@ -91,8 +94,6 @@ export class BallisticsTable
       });
 
       console.log(`[BallisticsTable] Range: ${range}m, Drop: ${drop_mrad.toFixed(2)}mrad, Spin Drift: ${spinDrift_mrad.toFixed(2)}mrad`);
-
-      point.delete();
     }
 
     const endTime = performance.now();
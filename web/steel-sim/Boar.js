@@ -51,6 +51,8 @@ export class Boar
     this.impactDetector = impactDetector;
     this.objectId = objectId;
     this.colliderHandle = -1; // Initialized after box calculation
+    this.colliderVelocity = new THREE.Vector3(); // m/s, sent with the collider transform
+    this.colliderTurnRate = 0; // rad/s about Y
 
     // Random speed multiplier between 0.5x and 2.0x
     this.speedMultiplier = 0.5 + Math.random() * 1.5; // 0.5 to 2.0
@@ -259,6 +261,10 @@ export class Boar
       quat.x, quat.y, quat.z, quat.w
     );
 
+    // Let the detector sweep the boar through the next frame's bullet window
+    const v = this.colliderVelocity;
+    this.impactDetector.setColliderVelocity(this.colliderHandle, v.x, v.y, v.z, 0, this.colliderTurnRate, 0);
+
     // Update debug wireframe mesh position
     if (this.debugColliderMesh)
     {
@@ -538,6 +544,10 @@ export class Boar
         }
         else
         {
+          // End of path: stand still
+          this.colliderVelocity.set(0, 0, 0);
+          this.colliderTurnRate = 0;
+          this.updateColliderTransform();
           return;
         }
       }
@@ -573,10 +583,12 @@ export class Boar
       if (Math.abs(angleDiff) <= maxTurn)
       {
         this.facingAngle = targetAngle;
+        this.colliderTurnRate = dt > 0 ? angleDiff / dt : 0;
       }
       else
       {
         this.facingAngle += Math.sign(angleDiff) * maxTurn;
+        this.colliderTurnRate = Math.sign(angleDiff) * this.turnSpeed;
       }
 
       // Normalize facing angle to [-PI, PI]
@@ -591,6 +603,7 @@ export class Boar
       );
       const moveDistance = this.speed * dt;
       this.position.addScaledVector(moveDir, moveDistance);
+      this.colliderVelocity.copy(moveDir).multiplyScalar(this.speed);
 
       // Update boar group position and rotation
       this.boarGroup.position.set(this.position.x, this.groundYOffset, this.position.z);
@@ -105,6 +105,7 @@ export class ImpactDetector
 
   /**
    * Find first impact of a trajectory in time interval [t0, t1].
+   * Collider poses are taken as current at t0; moving colliders are swept through the window.
    * 
    * @param {btk.Trajectory} trajectory BTK Trajectory instance
    * @param {number} t0 Start time in seconds
@@ -142,6 +143,65 @@ export class ImpactDetector
     };
   }
 
+  /**
+   * Find the first impact of each of many trajectories in [t0, t1] in one call.
+   * Meant for volleys and Monte Carlo hit probability; collider poses are taken as current at t0.
+   * 
+   * @param {btk.Trajectory[]} trajectories BTK Trajectory instances
+   * @param {number} t0 Start time in seconds
+   * @param {number} t1 End time in seconds
+   * @returns {Array<Object|null>} Per trajectory: impact result {position, normal, time, userData} or null
+   */
+  findFirstImpactBatch(trajectories, t0, t1)
+  {
+    const btk = window.btk;
+    const batch = new btk.TrajectoryVector();
+    for (const trajectory of trajectories)
+    {
+      batch.push_back(trajectory);
+    }
+
+    // Thread count is ignored by builds without pthreads
+    const results = this.detector.findFirstImpactBatch(batch, t0, t1, 0);
+    batch.delete();
+
+    const impacts = new Array(results.size());
+    for (let i = 0; i < impacts.length; i++)
+    {
+      const result = results.get(i);
+      impacts[i] = result.objectId < 0 ? null : {
+        position: { x: result.position.x, y: result.position.y, z: result.position.z },
+        normal: { x: result.normal.x, y: result.normal.y, z: result.normal.z },
+        time: result.time,
+        userData: this.userData.get(result.objectId)
+      };
+    }
+    results.delete();
+
+    return impacts;
+  }
+
+  /**
+   * Fraction of trajectories whose first impact in [t0, t1] is on the given object.
+   * 
+   * @param {btk.Trajectory[]} trajectories BTK Trajectory instances (e.g. Monte Carlo shots)
+   * @param {number} t0 Start time in seconds
+   * @param {number} t1 End time in seconds
+   * @param {*} userData User data the target was registered with
+   * @returns {number} Hit probability in [0, 1] (0 for an empty batch)
+   */
+  hitProbability(trajectories, t0, t1, userData)
+  {
+    if (trajectories.length === 0)
+    {
+      return 0;
+    }
+
+    const impacts = this.findFirstImpactBatch(trajectories, t0, t1);
+    const hits = impacts.filter(impact => impact !== null && impact.userData === userData).length;
+    return hits / trajectories.length;
+  }
+
   /**
    * Enable or disable a collider by handle.
    * Disabled colliders are skipped during collision detection.
@@ -185,6 +245,29 @@ export class ImpactDetector
     this.detector.moveCollider(handle, position, rotation);
   }
 
+  /**
+   * Set the velocity of a moving mesh collider.
+   * Moving colliders are tested against the pose they have at each point of the
+   * trajectory window instead of a pose frozen at the last moveCollider call.
+   * 
+   * @param {number} handle Collider handle
+   * @param {number} vx Linear velocity X in m/s
+   * @param {number} vy Linear velocity Y in m/s
+   * @param {number} vz Linear velocity Z in m/s
+   * @param {number} wx Angular velocity X in rad/s (about the collider position)
+   * @param {number} wy Angular velocity Y in rad/s
+   * @param {number} wz Angular velocity Z in rad/s
+   */
+  setColliderVelocity(handle, vx, vy, vz, wx = 0, wy = 0, wz = 0)
+  {
+    const btk = window.btk;
+    const linear = new btk.Vector3D(vx, vy, vz);
+    const angular = new btk.Vector3D(wx, wy, wz);
+    this.detector.setColliderVelocity(handle, linear, angular);
+    linear.delete();
+    angular.delete();
+  }
+
   /**
    * Remove a collider by handle.
    * 
@@ -3,6 +3,10 @@
  * 
  * Wraps render calls to automatically collect draw calls, triangles, points, and lines.
  * Call logStats() manually when you want to output the statistics.
+ *
+ * With an engine built with BTK_PROFILING, setEngineProfiler(btk.Profiler) also
+ * collects the engine's per-frame counters and timers (trajectory steps, wind
+ * samples, collision cells and triangles, steel substeps, texture pixels).
  */
 
 export class RenderStats
@@ -15,6 +19,31 @@ export class RenderStats
     this.frameCount = 0; // Number of frames tracked in current period
     this.totalFrameCount = 0; // Total frames since creation (never resets)
     this.periodStartTime = null; // Start time for current stats period
+    this.engineProfiler = null; // btk.Profiler when the engine was built with profiling
+    this.engineSnapshot = null; // Engine counters of the last completed frame
+    this.engineTotals = null; // Engine counters accumulated over the current period
+  }
+
+  /**
+   * Collect engine counters and timers each frame
+   * @param {Object} profiler - btk.Profiler (ignored unless the engine was built with BTK_PROFILING)
+   */
+  setEngineProfiler(profiler)
+  {
+    this.engineProfiler = profiler && profiler.isEnabled() ? profiler : null;
+    if (this.engineProfiler)
+    {
+      this.engineProfiler.reset();
+    }
+  }
+
+  /**
+   * Get the engine counters of the last completed frame
+   * @returns {Object|null} ProfilerFrameSnapshot, or null without engine profiling
+   */
+  getEngineSnapshot()
+  {
+    return this.engineSnapshot;
   }
 
   /**
@@ -101,6 +130,23 @@ export class RenderStats
     this.frameCount++;
     this.totalFrameCount++;
     this.frameStartTime = null;
+
+    // Close the engine's frame too, so its counters cover exactly this frame
+    if (this.engineProfiler)
+    {
+      this.engineSnapshot = this.engineProfiler.endFrame();
+      if (!this.engineTotals)
+      {
+        this.engineTotals = {};
+      }
+      for (const [key, value] of Object.entries(this.engineSnapshot))
+      {
+        if (key !== 'frame')
+        {
+          this.engineTotals[key] = (this.engineTotals[key] || 0) + value;
+        }
+      }
+    }
   }
 
   /**
@@ -151,6 +197,20 @@ export class RenderStats
       }
     }
 
+    if (this.engineTotals && this.frameCount > 0)
+    {
+      // Per-frame averages of the engine counters
+      const avg = {};
+      for (const [key, value] of Object.entries(this.engineTotals))
+      {
+        avg[key] = value / this.frameCount;
+      }
+      console.log(`[RenderStats] Engine trajectory: ${avg.trajectoryMs.toFixed(2)} ms, Steps: ${avg.trajectorySteps.toFixed(0)}`);
+      console.log(`[RenderStats] Engine wind: ${avg.windMs.toFixed(2)} ms, Samples: ${avg.windSamples.toFixed(0)}, Noise evaluations: ${avg.noiseEvaluations.toFixed(0)}`);
+      console.log(`[RenderStats] Engine collision: ${avg.impactDetectionMs.toFixed(2)} ms, Cells: ${avg.broadphaseCells.toFixed(0)}, Triangle tests: ${avg.triangleTests.toFixed(0)}`);
+      console.log(`[RenderStats] Engine steel: ${avg.steelPhysicsMs.toFixed(2)} ms, Substeps: ${avg.steelSubsteps.toFixed(0)}, Texture: ${avg.texturePaintMs.toFixed(2)} ms, Pixels: ${avg.texturePixels.toFixed(0)}`);
+    }
+
     console.log('[RenderStats] ========================');
   }
 
@@ -172,6 +232,7 @@ export class RenderStats
     this.frameTimes = [];
     this.frameCount = 0;
     this.periodStartTime = null;
+    this.engineTotals = null;
   }
 
   /**
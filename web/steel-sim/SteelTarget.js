@@ -5,9 +5,9 @@ import
 }
 from './config.js';
 
-// Atlas configuration - texture is 2x width for front/back halves
-const ATLAS_TILE_WIDTH = 1024; // 2x for front/back
-const ATLAS_TILE_HEIGHT = 512;
+// Atlas configuration - each target texture is 2x width for front/back halves
+const ATLAS_TILE_HEIGHT = 512; // Largest per-target texture height (and decal reference size)
+const ATLAS_PAGE_SIZE = 2048; // Shared atlas page width/height
 
 /**
  * Wrapper class for C++ SteelTarget physics object.
@@ -60,7 +60,10 @@ export class SteelTarget
     this.targetIndex = null;
     this.vertexOffset = null; // Offset in merged vertex buffer
     this.vertexCount = null; // Number of vertices for this target
-    this.atlasOffset = null; // Offset in atlas (y position)
+    this.atlasOffset = null; // Texture array layer (atlas page, or decal table row)
+    this.atlasIndex = null; // Index in the shared SteelTextureAtlas
+    this.atlasRect = null; // UV rectangle on the atlas page
+    this.atlasRegion = null; // Texel rectangle on the atlas page
 
     // Calculate attachment points
     let attachmentX, attachmentY;
@@ -83,6 +86,24 @@ export class SteelTarget
     initialPos.delete();
     defaultNormal.delete();
 
+    if (Config.TARGET_CONFIG.chainSolver === 'implicit')
+    {
+      this.steelTarget.setChainSolver(btk.SteelChainSolver.IMPLICIT);
+    }
+
+    // Impact marks: procedural mode keeps only the decal list (no RGBA buffer)
+    const paint = Config.TARGET_CONFIG.paintColor;
+    const metal = Config.TARGET_CONFIG.metalColor;
+    this.steelTarget.setColors(paint.r, paint.g, paint.b, metal.r, metal.g, metal.b);
+    if (SteelTargetFactory.isProcedural())
+    {
+      this.steelTarget.setTextureEnabled(false);
+    }
+    else
+    {
+      this.steelTarget.initializeTexture();
+    }
+
     // Add chain anchors
     const leftLocalAttach = new btk.Vector3D(-attachmentX, attachmentY, -thickness / 2);
     const rightLocalAttach = new btk.Vector3D(+attachmentX, attachmentY, -thickness / 2);
@@ -144,12 +165,19 @@ export class SteelTarget
   }
 
   /**
-   * Update texture in atlas
+   * Update impact marks (decal table or texture atlas)
    */
   updateTexture()
   {
     if (!this.steelTarget || this.targetIndex === null) return;
-    SteelTargetFactory.copyTextureToAtlas(this);
+    if (SteelTargetFactory.isProcedural())
+    {
+      SteelTargetFactory.copyDecalsToTexture(this);
+    }
+    else
+    {
+      SteelTargetFactory.copyTextureToAtlas(this);
+    }
   }
 
   /**
@@ -216,7 +244,7 @@ export class SteelTarget
   hit(bullet)
   {
     if (!this.steelTarget) return;
-    this.steelTarget.hit(bullet);
+    SteelTargetFactory.world.hit(this.worldIndex, bullet);
     this.updateTexture();
     SteelTargetFactory._moveToMoving(this);
   }
@@ -260,6 +288,9 @@ export class SteelTarget
     this.vertexOffset = null;
     this.vertexCount = null;
     this.atlasOffset = null;
+    this.atlasIndex = null;
+    this.atlasRect = null;
+    this.atlasRegion = null;
     this.chainInstanceIndices = [null, null];
   }
 }
@@ -275,12 +306,24 @@ export class SteelTargetFactory
   static allTargets = new Set();
   static movingTargets = new Set();
 
+  // Batch physics: one step call per frame for all awake targets
+  static world = null;
+  static targetsByWorldIndex = [];
+
   // Instanced mesh state
   static rectInstancedMesh = null;
   static ovalInstancedMesh = null;
   static edgeInstancedMesh = null;
   static atlasTexture = null;
-  static atlasData = null;
+  static textureAtlas = null; // btk.SteelTextureAtlas holding every target's texture
+  static renderer = null; // Uploads dirty rectangles straight into the atlas texture
+  static dirtyRowsTexture = null; // Source wrapper for those uploads (rows of an atlas page)
+  static dirtyRegion = new THREE.Box2();
+  static dirtyPosition = new THREE.Vector3();
+
+  // Procedural impact marks: one row per target, header texel (count) + 2 texels per decal
+  static decalTexture = null;
+  static decalData = null;
 
   // Instance data tracking
   static instanceData = new Map(); // target -> {instanceId, isOval}
@@ -294,6 +337,24 @@ export class SteelTargetFactory
   // Scene reference
   static scene = null;
 
+  /**
+   * Whether impact marks are drawn procedurally from decal lists
+   * @returns {boolean}
+   */
+  static isProcedural()
+  {
+    return Config.TARGET_CONFIG.impactMarks === 'procedural';
+  }
+
+  /**
+   * Texels per decal-table row
+   * @returns {number}
+   */
+  static decalRowTexels()
+  {
+    return 1 + 2 * Config.TARGET_CONFIG.maxImpactDecals;
+  }
+
   /**
    * Create a new steel target (adds to pending, no mesh yet)
    * @param {Object} options
@@ -302,6 +363,9 @@ export class SteelTargetFactory
   static create(options)
   {
     const target = new SteelTarget(options);
+    if (!this.world) this.world = new window.btk.SteelTargetWorld();
+    target.worldIndex = this.world.addTarget(target.steelTarget);
+    this.targetsByWorldIndex[target.worldIndex] = target;
     this.allTargets.add(target);
     this.movingTargets.add(target);
     return target;
@@ -311,10 +375,12 @@ export class SteelTargetFactory
    * Initialize instanced meshes after all targets are created.
    * Call this once after all targets exist.
    * @param {THREE.Scene} scene
+   * @param {THREE.WebGLRenderer} renderer - Renderer that draws the targets (uploads impact marks in texture mode)
    */
-  static initializeMergedMesh(scene)
+  static initializeMergedMesh(scene, renderer)
   {
     this.scene = scene;
+    this.renderer = renderer;
     const targets = [...this.allTargets];
     const numTargets = targets.length;
 
@@ -339,33 +405,60 @@ export class SteelTargetFactory
       }
     }
 
-    // Create texture array (one layer per target)
-    const pixelsPerLayer = ATLAS_TILE_WIDTH * ATLAS_TILE_HEIGHT * 4;
-    this.atlasData = new Uint8Array(pixelsPerLayer * numTargets);
+    if (this.isProcedural())
+    {
+      // Decal table (one row per target); targets start without impacts
+      this.decalData = new Float32Array(this.decalRowTexels() * 4 * numTargets);
+      this.decalTexture = new THREE.DataTexture(this.decalData, this.decalRowTexels(), numTargets, THREE.RGBAFormat, THREE.FloatType);
+      this.decalTexture.minFilter = THREE.NearestFilter;
+      this.decalTexture.magFilter = THREE.NearestFilter;
+      this.decalTexture.flipY = false;
+    }
+    else
+    {
+      // Pack every target texture into shared atlas pages, sized by its screen coverage at full zoom
+      const btk = window.btk;
+      const fovRad = THREE.MathUtils.degToRad(Config.TARGET_CONFIG.textureFovDeg);
+      this.textureAtlas = new btk.SteelTextureAtlas(ATLAS_PAGE_SIZE);
+      for (const target of targets)
+      {
+        const dims = target.steelTarget.getDimensions();
+        const pos = target.steelTarget.getCenterOfMass();
+        const size = btk.SteelTarget.textureSizeFor(Math.max(dims.x, dims.y), Math.hypot(pos.x, pos.z), fovRad,
+          Config.TARGET_CONFIG.textureViewportHeight, 1.0, ATLAS_TILE_HEIGHT);
+        target.atlasIndex = this.textureAtlas.addTarget(target.steelTarget, size);
+        target.atlasRect = this.textureAtlas.getUVRect(target.atlasIndex);
+        target.atlasRegion = this.textureAtlas.getRegion(target.atlasIndex);
+        target.atlasOffset = target.atlasRegion.page;
+        target.steelTarget.clearDirtyRect();
+      }
 
-    this.atlasTexture = new THREE.DataArrayTexture(
-      this.atlasData,
-      ATLAS_TILE_WIDTH,
-      ATLAS_TILE_HEIGHT,
-      numTargets
-    );
-    this.atlasTexture.format = THREE.RGBAFormat;
-    this.atlasTexture.type = THREE.UnsignedByteType;
-    this.atlasTexture.minFilter = THREE.LinearFilter;
-    this.atlasTexture.magFilter = THREE.LinearFilter;
-    this.atlasTexture.flipY = false;
-    this.atlasTexture.colorSpace = THREE.LinearSRGBColorSpace;
-
-    // Copy textures to array
+      // One texture array over the atlas pages (zero-copy view of the C++ buffer)
+      this.atlasTexture = new THREE.DataArrayTexture(
+        this.textureAtlas.getTexels(),
+        ATLAS_PAGE_SIZE,
+        ATLAS_PAGE_SIZE,
+        this.textureAtlas.getPageCount()
+      );
+      this.atlasTexture.format = THREE.RGBAFormat;
+      this.atlasTexture.type = THREE.UnsignedByteType;
+      this.atlasTexture.minFilter = THREE.LinearFilter;
+      this.atlasTexture.magFilter = THREE.LinearFilter;
+      this.atlasTexture.flipY = false;
+      this.atlasTexture.colorSpace = THREE.LinearSRGBColorSpace;
+      this.dirtyRowsTexture = new THREE.DataTexture(null, ATLAS_PAGE_SIZE, 1, THREE.RGBAFormat, THREE.UnsignedByteType);
+    }
+
+    // Assign table rows (procedural mode)
     let targetIndex = 0;
     for (const target of targets)
     {
       target.targetIndex = targetIndex;
-      target.atlasOffset = targetIndex;
-
-      const srcData = target.steelTarget.getTexture();
-      const layerOffset = targetIndex * pixelsPerLayer;
-      this.atlasData.set(srcData, layerOffset);
+      if (!this.atlasTexture)
+      {
+        target.atlasOffset = targetIndex;
+        this.copyDecalsToTexture(target);
+      }
       targetIndex++;
     }
 
@@ -398,9 +491,15 @@ export class SteelTargetFactory
       console.log(`  Created oval instanced mesh: ${ovalTargets.length} instances`);
     }
 
-    this.atlasTexture.needsUpdate = true;
-
-    console.log(`  Texture array: ${ATLAS_TILE_WIDTH}x${ATLAS_TILE_HEIGHT} x ${numTargets} layers`);
+    if (this.atlasTexture)
+    {
+      this.atlasTexture.needsUpdate = true;
+      console.log(`  Texture atlas: ${ATLAS_PAGE_SIZE}x${ATLAS_PAGE_SIZE} x ${this.textureAtlas.getPageCount()} pages for ${numTargets} targets`);
+    }
+    else
+    {
+      console.log(`  Decal table: ${this.decalRowTexels()} x ${numTargets} RGBA32F`);
+    }
     console.log(`  Rect instances: ${rectTargets.length}, Oval instances: ${ovalTargets.length}`);
   }
 
@@ -604,15 +703,36 @@ export class SteelTargetFactory
         `
       );
 
+      if (this.isProcedural())
+      {
+        this.addProceduralImpactShader(shader);
+        return;
+      }
+
+      // Per-instance UV rectangle on the atlas page
+      shader.vertexShader = `
+        attribute vec4 instanceUvRect;
+        varying vec4 vUvRect;
+      ` + shader.vertexShader.replace(
+        'vUv = uv;',
+        `vUv = uv;
+        vUvRect = instanceUvRect;`
+      );
+
       // Add texture array uniform
       shader.uniforms.mapArray = {
         value: this.atlasTexture
       };
+      shader.uniforms.atlasHalfTexel = {
+        value: 0.5 / ATLAS_PAGE_SIZE
+      };
 
       shader.fragmentShader = `
         uniform sampler2DArray mapArray;
+        uniform float atlasHalfTexel;
         varying float vTargetIndex;
         varying vec2 vUv;
+        varying vec4 vUvRect;
       ` + shader.fragmentShader;
 
       // Sample texture array (or use gray for edge faces with negative UVs)
@@ -624,8 +744,9 @@ export class SteelTargetFactory
           // Edge face - metal gray
           diffuseColor = vec4(0.55, 0.55, 0.55, opacity);
         } else {
-          // Front/back face - sample texture array
-          vec4 texColor = texture(mapArray, vec3(vUv, vTargetIndex));
+          // Front/back face - sample this target's region (kept off its neighbours' texels)
+          vec2 atlasUv = clamp(vUvRect.xy + vUv * vUvRect.zw, vUvRect.xy + atlasHalfTexel, vUvRect.xy + vUvRect.zw - atlasHalfTexel);
+          vec4 texColor = texture(mapArray, vec3(atlasUv, vTargetIndex));
           diffuseColor = texColor;
         }
         `
@@ -641,6 +762,109 @@ export class SteelTargetFactory
     return material;
   }
 
+  /**
+   * Draw impact marks from the decal table in the fragment shader.
+   * Mirrors SteelTarget::drawDecalOnTexture (C++) including its seeded spikes.
+   * @param {Object} shader - Shader passed to onBeforeCompile
+   */
+  static addProceduralImpactShader(shader)
+  {
+    const paint = Config.TARGET_CONFIG.paintColor;
+    const metal = Config.TARGET_CONFIG.metalColor;
+
+    shader.uniforms.decalMap = {
+      value: this.decalTexture
+    };
+    shader.uniforms.decalPaintColor = {
+      value: new THREE.Vector3(paint.r / 255, paint.g / 255, paint.b / 255)
+    };
+    shader.uniforms.decalMetalColor = {
+      value: new THREE.Vector3(metal.r / 255, metal.g / 255, metal.b / 255)
+    };
+    shader.uniforms.decalTextureSize = {
+      value: ATLAS_TILE_HEIGHT // Reference texels across one face, for spike widths
+    };
+
+    shader.fragmentShader = `
+      uniform sampler2D decalMap;
+      uniform vec3 decalPaintColor;
+      uniform vec3 decalMetalColor;
+      uniform float decalTextureSize;
+      varying float vTargetIndex;
+      varying vec2 vUv;
+
+      // SteelTarget::decalRandom (lowbias32)
+      float decalRandom(uint seed, uint index) {
+        uint x = seed * 0x9E3779B9u + index;
+        x ^= x >> 16u;
+        x *= 0x7FEB352Du;
+        x ^= x >> 15u;
+        x *= 0x846CA68Bu;
+        x ^= x >> 16u;
+        return float(x >> 8u) * (1.0 / 16777216.0);
+      }
+
+      vec3 impactColor(vec2 uv, int row) {
+        float face = uv.x < 0.5 ? 0.0 : 1.0;
+        vec2 p = vec2(uv.x * 2.0 - face, uv.y);
+        vec3 color = decalPaintColor;
+        int count = int(texelFetch(decalMap, ivec2(0, row), 0).x);
+        for (int i = 0; i < count; i++) {
+          vec4 a = texelFetch(decalMap, ivec2(1 + 2 * i, row), 0); // u, v, radius_u, radius_v
+          vec4 b = texelFetch(decalMap, ivec2(2 + 2 * i, row), 0); // face, seed, spike count
+          if (b.x != face) continue;
+
+          vec2 r = max(a.zw * decalTextureSize, vec2(3.0)); // Splatter radius in texels
+          vec2 q = (p - a.xy) * decalTextureSize;          // Offset in texels
+          vec2 n = q / r;
+          float d2 = dot(n, n);
+          if (d2 > 16.0) continue; // Beyond the longest spike
+
+          if (d2 <= 1.0) color = mix(decalMetalColor, decalPaintColor, d2);
+
+          uint seed = uint(b.y);
+          int spikes = int(b.z);
+          for (int k = 0; k < spikes; k++) {
+            uint j = uint(k) * 3u;
+            float angle = 6.2831853 * float(k) / float(spikes) - 0.3 + 0.6 * decalRandom(seed, j + 1u);
+            float len = 3.0 * (0.8 + 0.4 * decalRandom(seed, j + 2u));
+            float width = 2.5 * (0.8 + 0.4 * decalRandom(seed, j + 3u));
+            float c = cos(angle);
+            float s = sin(angle);
+
+            // Solve q = t * (c * r.x, s * r.y) + w * (s, -c): t along the spike, w across in texels
+            float denom = c * c * r.x + s * s * r.y;
+            float t = (c * q.x + s * q.y) / denom;
+            float w = (s * r.y * q.x - c * r.x * q.y) / denom;
+            if (t >= 0.0 && t < len && abs(w) <= width * (1.0 - t / len)) {
+              float fade = t / len;
+              color = mix(decalMetalColor, decalPaintColor, fade * fade);
+            }
+          }
+        }
+        return color;
+      }
+    ` + shader.fragmentShader;
+
+    shader.fragmentShader = shader.fragmentShader.replace(
+      'vec4 diffuseColor = vec4( diffuse, opacity );',
+      `
+      vec4 diffuseColor;
+      if (vUv.x < 0.0) {
+        // Edge face - metal gray
+        diffuseColor = vec4(0.55, 0.55, 0.55, opacity);
+      } else {
+        diffuseColor = vec4(impactColor(vUv, int(vTargetIndex + 0.5)), opacity);
+      }
+      `
+    );
+
+    shader.fragmentShader = shader.fragmentShader.replace(
+      '#include <map_fragment>',
+      '// map_fragment replaced by procedural impact marks'
+    );
+  }
+
   // Reusable objects for matrix computation
   static _matrix = new THREE.Matrix4();
   static _position = new THREE.Vector3();
@@ -654,6 +878,7 @@ export class SteelTargetFactory
   {
     const count = targets.length;
     const targetIndexArray = new Float32Array(count);
+    const uvRectArray = new Float32Array(count * 4);
 
     for (let i = 0; i < count; i++)
     {
@@ -676,8 +901,12 @@ export class SteelTargetFactory
       this._matrix.compose(this._position, this._quaternion, this._scale);
       instancedMesh.setMatrixAt(i, this._matrix);
 
-      // Store target index for texture array
-      targetIndexArray[i] = target.targetIndex;
+      // Store texture array layer and atlas rectangle
+      targetIndexArray[i] = target.atlasOffset;
+      if (target.atlasRect)
+      {
+        uvRectArray.set([target.atlasRect.u, target.atlasRect.v, target.atlasRect.width, target.atlasRect.height], i * 4);
+      }
 
       // Store instance info for updates
       this.instanceData.set(target,
@@ -689,6 +918,7 @@ export class SteelTargetFactory
 
     // Add target index as instanced attribute
     instancedMesh.geometry.setAttribute('instanceTargetIndex', new THREE.InstancedBufferAttribute(targetIndexArray, 1));
+    instancedMesh.geometry.setAttribute('instanceUvRect', new THREE.InstancedBufferAttribute(uvRectArray, 4));
     instancedMesh.instanceMatrix.needsUpdate = true;
   }
 
@@ -764,40 +994,65 @@ export class SteelTargetFactory
   }
 
   /**
-   * Copy a target's texture to the texture array
+   * Upload the rectangle of the atlas a target drew new marks into
    * @param {SteelTarget} target
    */
   static copyTextureToAtlas(target)
   {
-    if (!this.atlasTexture || target.atlasOffset === null) return;
-
-    const srcData = target.steelTarget.getTexture();
-    const layerIndex = target.atlasOffset;
-    const pixelsPerLayer = ATLAS_TILE_WIDTH * ATLAS_TILE_HEIGHT * 4;
-    const layerOffset = layerIndex * pixelsPerLayer;
-
-    this.atlasData.set(srcData, layerOffset);
-    this.atlasTexture.needsUpdate = true;
+    if (!this.atlasTexture || target.atlasIndex === null) return;
+    if (!target.steelTarget.hasDirtyRect()) return;
+    const dirty = target.steelTarget.getDirtyRect();
+    target.steelTarget.clearDirtyRect();
+
+    // The target drew straight into the atlas; re-fetch the view in case WASM memory grew
+    // (it is only read again if the whole texture is uploaded, e.g. on first use)
+    this.atlasTexture.image.data = this.textureAtlas.getTexels();
+
+    // Upload only the dirty rectangle, offset by the target's region: the source is the
+    // page rows it spans (zero-copy), clipped to its columns by the source region
+    const region = target.atlasRegion;
+    const x = region.x + dirty.x;
+    const y = region.y + dirty.y;
+    this.dirtyRowsTexture.image =
+    {
+      data: this.textureAtlas.getPageRows(region.page, y, dirty.height),
+      width: ATLAS_PAGE_SIZE,
+      height: dirty.height
+    };
+    this.dirtyRegion.min.set(x, 0);
+    this.dirtyRegion.max.set(x + dirty.width, dirty.height);
+    this.dirtyPosition.set(x, y, region.page);
+    this.renderer.copyTextureToTexture(this.dirtyRowsTexture, this.atlasTexture, this.dirtyRegion, this.dirtyPosition);
   }
 
   /**
-   * Move target to moving set
+   * Copy a target's most recent impact decals to its row of the decal table
    * @param {SteelTarget} target
-   * @private
    */
-  static _moveToMoving(target)
+  static copyDecalsToTexture(target)
   {
-    this.movingTargets.add(target);
+    if (!this.decalTexture || target.atlasOffset === null) return;
+
+    const maxDecals = Config.TARGET_CONFIG.maxImpactDecals;
+    const stride = window.btk.SteelTarget.DECAL_STRIDE;
+    const decals = target.steelTarget.getDecals();
+    const total = target.steelTarget.getDecalCount();
+    const count = Math.min(total, maxDecals);
+    const rowOffset = target.atlasOffset * this.decalRowTexels() * 4;
+
+    this.decalData[rowOffset] = count;
+    this.decalData.set(decals.subarray((total - count) * stride, total * stride), rowOffset + 4);
+    this.decalTexture.needsUpdate = true;
   }
 
   /**
-   * Move target to settled set
+   * Move target to moving set
    * @param {SteelTarget} target
    * @private
    */
-  static _moveToSettled(target)
+  static _moveToMoving(target)
   {
-    this.movingTargets.delete(target);
+    this.movingTargets.add(target);
   }
 
   /**
@@ -810,6 +1065,12 @@ export class SteelTargetFactory
     if (this.allTargets.delete(target))
     {
       this.movingTargets.delete(target);
+      this.world.removeTarget(target.worldIndex);
+      if (this.textureAtlas && target.atlasIndex !== null)
+      {
+        this.textureAtlas.removeTarget(target.atlasIndex);
+      }
+      this.targetsByWorldIndex[target.worldIndex] = null;
       target.dispose();
       return true;
     }
@@ -821,6 +1082,19 @@ export class SteelTargetFactory
    */
   static deleteAll()
   {
+    if (this.world)
+    {
+      this.world.clear();
+    }
+    this.targetsByWorldIndex = [];
+
+    if (this.textureAtlas)
+    {
+      this.textureAtlas.clear();
+      this.textureAtlas.delete();
+      this.textureAtlas = null;
+    }
+
     for (const target of this.allTargets)
     {
       target.dispose();
@@ -858,6 +1132,20 @@ export class SteelTargetFactory
       this.atlasTexture = null;
     }
 
+    if (this.dirtyRowsTexture)
+    {
+      this.dirtyRowsTexture.dispose();
+      this.dirtyRowsTexture = null;
+    }
+    this.renderer = null;
+
+    if (this.decalTexture)
+    {
+      this.decalTexture.dispose();
+      this.decalTexture = null;
+    }
+    this.decalData = null;
+
     if (this.chainMesh && this.chainScene)
     {
       this.chainScene.remove(this.chainMesh);
@@ -866,7 +1154,6 @@ export class SteelTargetFactory
       this.chainMesh = null;
     }
 
-    this.atlasData = null;
     this.instanceData.clear();
     this.nextInstanceId = 0;
     this.chainScene = null;
@@ -880,16 +1167,16 @@ export class SteelTargetFactory
    */
   static stepPhysics(dt)
   {
-    const targetsToProcess = [...this.movingTargets];
+    if (!this.world) return;
 
-    for (const target of targetsToProcess)
-    {
-      target.stepPhysics(dt);
+    // Settled targets drop out of the world's awake list
+    this.world.step(dt);
+    const awake = this.world.getAwakeIndices();
 
-      if (!target.isMoving())
-      {
-        this._moveToSettled(target);
-      }
+    this.movingTargets.clear();
+    for (let i = 0; i < awake.length; i++)
+    {
+      this.movingTargets.add(this.targetsByWorldIndex[awake[i]]);
     }
   }
 
@@ -62,7 +62,24 @@ export function initConfig()
     defaultBeamHeight: btk.Conversions.yardsToMeters(2.5), // 2.5 yards - default overhead beam height
     chainRadius: btk.Conversions.inchesToMeters(0.25), // 1/2" diameter chains
     beamRadius: btk.Conversions.inchesToMeters(1.0), // 2" diameter beams
-    postRadius: btk.Conversions.inchesToMeters(1.0) // 2" diameter posts
+    postRadius: btk.Conversions.inchesToMeters(1.0), // 2" diameter posts
+    chainSolver: 'implicit', // 'implicit' (adaptive substeps, 3-11x cheaper; within 3.8 deg of the converged swing from 0.3 m) or 'spring' (1 ms substeps)
+    impactMarks: 'procedural', // 'procedural' (decals drawn in the shader) or 'texture' (CPU-rasterised RGBA)
+    maxImpactDecals: 64, // Most recent decals drawn per target in procedural mode
+    textureFovDeg: 1.0, // Narrowest scope field of view, for sizing texture-mode plate textures
+    textureViewportHeight: 1024, // Scope view height in pixels, for sizing texture-mode plate textures
+    paintColor:
+    {
+      r: 255,
+      g: 40,
+      b: 40
+    },
+    metalColor:
+    {
+      r: 140,
+      g: 140,
+      b: 140
+    }
   };
   // ===== DUST CLOUD CONFIGURATIONS =====
   Config.GROUND_DUST_CONFIG = {
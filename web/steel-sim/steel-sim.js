@@ -1,4 +1,4 @@
-import BallisticsToolkit from '../ballistics_toolkit_wasm.js';
+import BallisticsToolkit from '../btk-loader.js';
 import * as THREE from 'three';
 import
 {
@@ -306,6 +306,7 @@ class SteelSimulator
         this.btk = await BallisticsToolkit();
         window.btk = this.btk;
       }
+      this.renderStats.setEngineProfiler(this.btk.Profiler);
 
       // Initialize config with SI unit values
       initConfig();
@@ -778,7 +779,7 @@ class SteelSimulator
     TargetRackFactory.initializePostInstancing(this.scene);
 
     // Initialize merged geometry for all steel targets (1 draw call)
-    SteelTargetFactory.initializeMergedMesh(this.scene);
+    SteelTargetFactory.initializeMergedMesh(this.scene, this.compositionRenderer.renderer);
 
     // Initialize instanced chain mesh for all targets
     SteelTargetFactory.initializeChainInstancing(this.scene);
@@ -2332,8 +2333,8 @@ class SteelSimulator
       const trajectory = shot.getTrajectory();
       if (!trajectory) continue;
 
-      // Only check the new time range since last frame
-      const impact = this.impactDetector.findFirstImpact(trajectory, timeRange.t0 - 0.001, timeRange.t1 + 0.001);
+      // Only check the new time range since last frame; moving targets are swept through it
+      const impact = this.impactDetector.findFirstImpact(trajectory, timeRange.t0, timeRange.t1);
 
       // If we hit something, handle it
       if (impact && impact.userData)
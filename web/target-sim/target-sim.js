@@ -3,7 +3,7 @@
  * Web GUI for ballistic match simulation using WebAssembly
  */
 
-import BallisticsToolkit from '../ballistics_toolkit_wasm.js';
+import BallisticsToolkit from '../btk-loader.js';
 
 let btk = null;
 
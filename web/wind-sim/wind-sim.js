@@ -1,4 +1,4 @@
-import BallisticsToolkit from '../ballistics_toolkit_wasm.js';
+import BallisticsToolkit from '../btk-loader.js';
 import * as THREE from 'three';
 import
 {